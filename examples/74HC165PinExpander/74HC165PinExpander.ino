@@ -16,6 +16,7 @@
 #include "Arduino.h"
 
 #include <EventButton.h>
+#include <InputManager.h>
 #include <GpioExpanderAdapter/HC165ExpanderAdapter.h>
 #include <PinAdapter/ExpanderPinAdapter.h>
 
@@ -35,6 +36,8 @@ EventButton buttons[NUM_BUTTONS] = {
     new ExpanderPinAdapter(7, expanderAdapter),
 };
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 /**
  * Utility function to print the button events to Serial.
  * You don't need this - it's just for the example.
@@ -107,6 +110,7 @@ void setup() {
     // connect buttons to events
     for (int i = 0; i < NUM_BUTTONS; i++) {
         buttons[i].begin();
+        inputs.add(buttons[i]);
         buttons[i].setInputId(i);
         buttons[i].setCallback(onButtonEvent);
     }
@@ -118,10 +122,8 @@ void loop() {
     // You must call update() to refresh the 74HC165(s)
     expanderAdapter.update();
 
-    // You must call update() for every defined EventButton.
-    // This will update the state of the button and 
+    // Update every input added to the InputManager.
+    // This will update the state of each button and 
     // fire the appropriate events.
-    for (int i = 0; i < NUM_BUTTONS; i++) {
-        buttons[i].update();
-    }
+    inputs.update();
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
  * A basic example of using the EventAnalog.
  */
 #include <EventAnalog.h>
+#include <InputManager.h>
 
 
 const uint8_t analogPin = A0;;   //Change to suit your wiring, must be an analog pin
@@ -50,10 +51,13 @@ void onAnalogEvent(InputEventType et, EventAnalog& ea) {
 
 EventAnalog myAnalog(analogPin); // Create an EventAnalog.
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   myAnalog.begin();
+  inputs.add(myAnalog);
   delay(500);
   Serial.println("EventAnalog Basic Example");
   //Optionally initialise at the low end of the potentiometer
@@ -66,8 +70,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventAnalog.
-  // This will update the state of the encoder and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myAnalog.update();
+  inputs.update();
 }
@@ -0,0 +1,445 @@
+/**
+ * Measures the cost of update() for each input class in a number of
+ * scenarios and prints the results as CSV:
+ *
+ *   input,variant,scenario,updates,per_update,unit
+ *
+ * per_update is CPU cycles (ESP32, ESP8266, RP2040, Teensy and the host
+ * build) or microseconds on boards without a cycle counter - see unit and
+ * CycleCounter. Each scenario is run RUNS times and the best is reported.
+ * The cost of driving the inputs (the 'step') is measured separately and
+ * subtracted.
+ *
+ * Inputs are driven by VirtualPinAdapters and a virtual encoder so no
+ * wiring is needed, except EventAnalog and EventJoystick which read A0
+ * (and A1). Their 'moving' scenarios are only run on the host build, where
+ * the ADC can be scripted.
+ *
+ * The 74HC165 expander adapters (bit-banged, direct port and SPI) are
+ * timed reading a cascade of four. They do not need a 74HC165 connected
+ * but do drive HC165_CLOCK_PIN, the SH/LD pins and the SPI bus. On the
+ * host the SPI library is a mock, so only board numbers are meaningful.
+ *
+ * Decoding 1 to 16 encoders on one expander is timed per pin (an
+ * ExpanderEncoderAdapter per encoder, two read()s each) and with one
+ * QuadratureWordDecoder for all of them, with one encoder turning
+ * (one_of_N) and with all of them turning at once (all_of_N).
+ *
+ * EventEncoder divides the adapter's position with a shift when the
+ * position divider is a power of two (the default 4) and an integer
+ * division otherwise (divider_3), and only when the position has changed.
+ * The position_divider rows time just the division, as it was (through
+ * float floor()) and as it is now. The saving is on boards without a
+ * hardware divider (eg AVR), where it also no longer links in the float
+ * conversions - compare the flash used by a sketch with an EventEncoder.
+ *
+ * Lines starting with # are comments. To compare two runs (eg before and
+ * after a change, or two debouncers) diff or join the CSV on the first
+ * three columns.
+ *
+ * On the host (see docs/HostBuild.md): build-host/Benchmark -t 5000
+ *
+ */
+
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventEncoder.h>
+#include <EventEncoderButton.h>
+#include <EventAnalog.h>
+#include <EventJoystick.h>
+#include <InputManager.h>
+#include <CycleCounter.h>
+#include <PinAdapter/VirtualPinAdapter.h>
+#include <EncoderAdapter/BaseTableEncoderAdapter.h>
+#include <EncoderAdapter/ExpanderEncoderAdapter.h>
+#include <EncoderAdapter/QuadratureWordDecoder.h>
+#include <GpioExpanderAdapter/HC165ExpanderAdapter.h>
+#include <GpioExpanderAdapter/HC165PortExpanderAdapter.h>
+#include <GpioExpanderAdapter/HC165SPIExpanderAdapter.h>
+
+const uint16_t UPDATES = 1000;
+const uint8_t RUNS = 3;
+
+#define HC165_DATA_PIN 5
+#define HC165_CLOCK_PIN 6
+#define HC165_SHLD_PIN 7
+#define HC165_SPI_SHLD_PIN 8
+#define HC165_CASCADE 4
+
+/**
+ * An encoder adapter that steps through the quadrature sequence on request.
+ */
+class VirtualEncoderAdapter : public BaseTableEncoderAdapter {
+public:
+  VirtualEncoderAdapter() {
+    _pinA = 0;
+    _pinB = 1;
+  }
+  bool begin() override { return true; }
+  void step() { phase = (phase + 1) & 3; }
+protected:
+  uint8_t readPin(uint8_t pin) const override {
+    static const uint8_t gray[4] = { 0, 1, 3, 2 };
+    return (gray[phase] >> (pin == _pinA ? 1 : 0)) & 1;
+  }
+private:
+  uint8_t phase = 0;
+};
+
+/**
+ * An expander whose pins are set by the benchmark.
+ */
+class VirtualExpanderAdapter : public GpioExpanderAdapter {
+public:
+  void begin() override {}
+  void update() override {}
+  bool read(byte pin) override { return (pins >> pin) & 1; }
+  uint32_t readAll() override { return pins; }
+  void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+  uint32_t pins = 0xFFFFFFFF;
+};
+
+VirtualPinAdapter buttonPin;
+VirtualPinAdapter rawButtonPin;
+VirtualPinAdapter switchPin;
+VirtualPinAdapter encoderButtonPin;
+VirtualEncoderAdapter encoderAdapter;
+VirtualEncoderAdapter encoderButtonAdapter;
+
+EventButton button(&buttonPin);
+EventButton rawButton(&rawButtonPin, false);
+EventSwitch eventSwitch(&switchPin);
+EventEncoder encoder(&encoderAdapter);
+EventEncoderButton encoderButton(&encoderButtonAdapter, &encoderButtonPin);
+EventAnalog analog(A0);
+EventJoystick joystick(A0, A1);
+
+InputManager inputs;
+
+HC165ExpanderAdapter hc165(HC165_DATA_PIN, HC165_CLOCK_PIN, HC165_SHLD_PIN, HC165_CASCADE);
+HC165PortExpanderAdapter hc165Port(HC165_DATA_PIN, HC165_CLOCK_PIN, HC165_SHLD_PIN, HC165_CASCADE);
+HC165SPIExpanderAdapter hc165Spi(HC165_SPI_SHLD_PIN, HC165_CASCADE);
+
+VirtualExpanderAdapter encoderExpander;
+ExpanderEncoderAdapter* pinEncoders[QuadratureWordDecoder::MAX_ENCODERS];
+int32_t wordPositions[QuadratureWordDecoder::MAX_ENCODERS];
+QuadratureWordDecoder wordDecoder(wordPositions, QuadratureWordDecoder::MAX_ENCODERS);
+uint8_t encoderCount = 0;
+
+uint32_t eventCount = 0;
+
+void onButtonEvent(InputEventType et, EventButton& ie) { eventCount++; }
+void onSwitchEvent(InputEventType et, EventSwitch& ie) { eventCount++; }
+void onEncoderEvent(InputEventType et, EventEncoder& ie) { eventCount++; }
+void onEncoderButtonEvent(InputEventType et, EventEncoderButton& ie) { eventCount++; }
+void onAnalogEvent(InputEventType et, EventAnalog& ie) { eventCount++; }
+void onJoystickEvent(InputEventType et, EventJoystick& ie) { eventCount++; }
+
+/*
+ * Scenario steps - called before every update() (and in the baseline run)
+ */
+
+void stepNone(uint16_t i) {}
+
+void stepBounceButton(uint16_t i) { buttonPin.setState(i & 1); }
+
+void stepBounceRawButton(uint16_t i) { rawButtonPin.setState(i & 1); }
+
+void stepBounceSwitch(uint16_t i) { switchPin.setState(i & 1); }
+
+void stepBounceEncoderButton(uint16_t i) { encoderButtonPin.setState(i & 1); }
+
+void stepRotateEncoder(uint16_t i) { encoderAdapter.step(); }
+
+void stepRotateEncoderButton(uint16_t i) { encoderButtonAdapter.step(); }
+
+// A position moving back and forth across zero, for the position_divider rows
+volatile int32_t rawPosition = 0;
+volatile uint8_t divider = 3;
+volatile int32_t dividedPosition = 0;
+
+void stepRawPosition(uint16_t i) { rawPosition = (int32_t)(i & 0xFF) - 128; }
+
+// One step along the quadrature sequence for every encoder (A on even pins, B on odd pins)
+const uint32_t encoderSequence[4] = { 0x00000000, 0xAAAAAAAA, 0xFFFFFFFF, 0x55555555 };
+
+void stepRotateExpanderEncoders(uint16_t i) {
+  encoderExpander.pins = encoderSequence[i & 3];
+}
+
+void stepRotateExpanderEncoder(uint16_t i) {
+  encoderExpander.pins = (encoderSequence[i & 3] & 3) | 0xFFFFFFFC;
+}
+
+#ifdef INPUT_EVENTS_HOST
+void stepMoveAnalog(uint16_t i) {
+  HostArduino::setAnalog(A0, (i * 8) & 1023);
+  HostArduino::advanceMicros(50); // EventAnalog reads at most once per millisecond
+}
+#endif
+
+/*
+ * Scenario preparation - put the inputs in a known state
+ */
+
+void settle() {
+  // Let the debouncers see a steady state
+  for (uint8_t i = 0; i < 3; i++) {
+    inputs.update();
+    delay(11);
+  }
+  inputs.update();
+}
+
+void prepareReleased() {
+  buttonPin.release();
+  rawButtonPin.release();
+  switchPin.release();
+  encoderButtonPin.release();
+  encoder.setPositionDivider(); // 4, divided with a shift
+  settle();
+}
+
+void prepareDivider3() {
+  prepareReleased();
+  encoder.setPositionDivider(3);
+}
+
+void preparePressed() {
+  buttonPin.press();
+  rawButtonPin.press();
+  switchPin.press();
+  encoderButtonPin.press();
+  settle();
+}
+
+void prepareScheduled() {
+  prepareReleased();
+  inputs.enableScheduling();
+}
+
+struct Scenario {
+  const char* input;
+  const char* variant;
+  const char* scenario;
+  EventInputBase* target; // nullptr for the InputManager
+  void (*prepare)();
+  void (*step)(uint16_t);
+};
+
+Scenario scenarios[] = {
+  { "EventButton", "foltman", "idle", &button, prepareReleased, stepNone },
+  { "EventButton", "foltman", "pressed", &button, preparePressed, stepNone },
+  { "EventButton", "foltman", "bouncing", &button, prepareReleased, stepBounceButton },
+  { "EventButton", "none", "idle", &rawButton, prepareReleased, stepNone },
+  { "EventButton", "none", "pressed", &rawButton, preparePressed, stepNone },
+  { "EventButton", "none", "bouncing", &rawButton, prepareReleased, stepBounceRawButton },
+  { "EventSwitch", "foltman", "idle", &eventSwitch, prepareReleased, stepNone },
+  { "EventSwitch", "foltman", "pressed", &eventSwitch, preparePressed, stepNone },
+  { "EventSwitch", "foltman", "bouncing", &eventSwitch, prepareReleased, stepBounceSwitch },
+  { "EventEncoder", "table", "idle", &encoder, prepareReleased, stepNone },
+  { "EventEncoder", "table", "rotating", &encoder, prepareReleased, stepRotateEncoder },
+  { "EventEncoder", "divider_3", "rotating", &encoder, prepareDivider3, stepRotateEncoder },
+  { "EventEncoderButton", "table", "idle", &encoderButton, prepareReleased, stepNone },
+  { "EventEncoderButton", "table", "pressed", &encoderButton, preparePressed, stepNone },
+  { "EventEncoderButton", "table", "bouncing", &encoderButton, prepareReleased, stepBounceEncoderButton },
+  { "EventEncoderButton", "table", "rotating", &encoderButton, prepareReleased, stepRotateEncoderButton },
+  { "EventEncoderButton", "table", "pressed_rotating", &encoderButton, preparePressed, stepRotateEncoderButton },
+  { "EventAnalog", "adc", "idle", &analog, prepareReleased, stepNone },
+  { "EventJoystick", "adc", "idle", &joystick, prepareReleased, stepNone },
+  #ifdef INPUT_EVENTS_HOST
+  { "EventAnalog", "adc", "moving", &analog, prepareReleased, stepMoveAnalog },
+  { "EventJoystick", "adc", "moving", &joystick, prepareReleased, stepMoveAnalog },
+  #endif
+  { "InputManager", "polled", "idle", nullptr, prepareReleased, stepNone },
+  { "InputManager", "scheduled", "idle", nullptr, prepareScheduled, stepNone },
+};
+
+struct ExpanderScenario {
+  const char* expander;
+  const char* variant;
+  GpioExpanderAdapter* target;
+};
+
+ExpanderScenario expanderScenarios[] = {
+  { "HC165ExpanderAdapter", "digital", &hc165 },
+  #ifdef INPUT_EVENTS_HC165_PORT_IO
+  { "HC165PortExpanderAdapter", "port", &hc165Port },
+  #else
+  { "HC165PortExpanderAdapter", "digital", &hc165Port },
+  #endif
+  { "HC165SPIExpanderAdapter", "spi", &hc165Spi },
+};
+
+EventInputBase* target = nullptr;
+GpioExpanderAdapter* expanderTarget = nullptr;
+
+void updateExpander() {
+  expanderTarget->update();
+}
+
+void updateTarget() {
+  if ( target ) {
+    target->update();
+  } else {
+    inputs.update();
+  }
+}
+
+void updatePinEncoders() {
+  for (uint8_t e = 0; e < encoderCount; e++) {
+    pinEncoders[e]->getPosition();
+  }
+}
+
+void updateWordDecoder() {
+  wordDecoder.update(encoderExpander);
+}
+
+void updateNothing() {}
+
+// EventEncoder's division before it was integer only
+void divideFloor() {
+  dividedPosition = floor(rawPosition / divider);
+}
+
+// EventEncoder::dividePosition() for a divider that is not a power of two
+void divideInteger() {
+  int32_t raw = rawPosition;
+  uint8_t d = divider;
+  int32_t divided = raw / d;
+  if ( raw < 0 && divided * d != raw ) divided--;
+  dividedPosition = divided;
+}
+
+// EventEncoder::dividePosition() for a power of two
+void divideShift() {
+  dividedPosition = rawPosition >> 2;
+}
+
+uint32_t timeRun(void (*update)(), void (*step)(uint16_t)) {
+  uint32_t start = CycleCounter::read();
+  for (uint16_t i = 0; i < UPDATES; i++) {
+    step(i);
+    update();
+  }
+  return CycleCounter::read() - start;
+}
+
+void printResult(const char* input, const char* variant, const char* scenario, uint32_t best) {
+  Serial.print(input);
+  Serial.print(",");
+  Serial.print(variant);
+  Serial.print(",");
+  Serial.print(scenario);
+  Serial.print(",");
+  Serial.print(UPDATES);
+  Serial.print(",");
+  Serial.print((float)best / UPDATES, 2);
+  Serial.print(",");
+  Serial.println(CycleCounter::isMicros() ? "us" : "cycles");
+}
+
+void runScenario(Scenario& s) {
+  target = s.target;
+  uint32_t best = 0xFFFFFFFF;
+  for (uint8_t run = 0; run < RUNS; run++) {
+    s.prepare();
+    uint32_t measured = timeRun(updateTarget, s.step);
+    uint32_t baseline = timeRun(updateNothing, s.step);
+    uint32_t cost = measured > baseline ? measured - baseline : 0;
+    if ( cost < best ) best = cost;
+  }
+  inputs.enableScheduling(false);
+  printResult(s.input, s.variant, s.scenario, best);
+}
+
+void runExpanderScenario(ExpanderScenario& s) {
+  expanderTarget = s.target;
+  uint32_t best = 0xFFFFFFFF;
+  for (uint8_t run = 0; run < RUNS; run++) {
+    uint32_t measured = timeRun(updateExpander, stepNone);
+    uint32_t baseline = timeRun(updateNothing, stepNone);
+    uint32_t cost = measured > baseline ? measured - baseline : 0;
+    if ( cost < best ) best = cost;
+  }
+  printResult(s.expander, s.variant, "cascade_4", best);
+}
+
+uint32_t timeBest(void (*update)(), void (*step)(uint16_t)) {
+  uint32_t best = 0xFFFFFFFF;
+  for (uint8_t run = 0; run < RUNS; run++) {
+    uint32_t measured = timeRun(update, step);
+    uint32_t baseline = timeRun(updateNothing, step);
+    uint32_t cost = measured > baseline ? measured - baseline : 0;
+    if ( cost < best ) best = cost;
+  }
+  return best;
+}
+
+void runEncoderDecoderScenarios() {
+  static const uint8_t counts[] = { 1, 2, 4, 8, 16 };
+  static const char* oneNames[] = { "one_of_1", "one_of_2", "one_of_4", "one_of_8", "one_of_16" };
+  static const char* allNames[] = { "all_of_1", "all_of_2", "all_of_4", "all_of_8", "all_of_16" };
+  for (uint8_t e = 0; e < QuadratureWordDecoder::MAX_ENCODERS; e++) {
+    pinEncoders[e] = new ExpanderEncoderAdapter(e * 2, e * 2 + 1, encoderExpander);
+    pinEncoders[e]->begin();
+  }
+  for (uint8_t c = 0; c < sizeof(counts); c++) {
+    encoderCount = counts[c];
+    wordDecoder = QuadratureWordDecoder(wordPositions, encoderCount);
+    wordDecoder.begin(encoderExpander);
+    printResult("ExpanderEncoderAdapter", "per_pin", oneNames[c], timeBest(updatePinEncoders, stepRotateExpanderEncoder));
+    printResult("QuadratureWordDecoder", "word", oneNames[c], timeBest(updateWordDecoder, stepRotateExpanderEncoder));
+    printResult("ExpanderEncoderAdapter", "per_pin", allNames[c], timeBest(updatePinEncoders, stepRotateExpanderEncoders));
+    printResult("QuadratureWordDecoder", "word", allNames[c], timeBest(updateWordDecoder, stepRotateExpanderEncoders));
+  }
+}
+
+void runDividerScenarios() {
+  divider = 3;
+  printResult("position_divider", "floor", "divide_3", timeBest(divideFloor, stepRawPosition));
+  printResult("position_divider", "integer", "divide_3", timeBest(divideInteger, stepRawPosition));
+  divider = 4;
+  printResult("position_divider", "floor", "divide_4", timeBest(divideFloor, stepRawPosition));
+  printResult("position_divider", "shift", "divide_4", timeBest(divideShift, stepRawPosition));
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  CycleCounter::begin();
+
+  button.setCallback(onButtonEvent);
+  rawButton.setCallback(onButtonEvent);
+  eventSwitch.setCallback(onSwitchEvent);
+  encoder.setCallback(onEncoderEvent);
+  encoderButton.setCallback(onEncoderButtonEvent);
+  analog.setCallback(onAnalogEvent);
+  joystick.setCallback(onJoystickEvent);
+
+  EventInputBase* all[] = { &button, &rawButton, &eventSwitch, &encoder, &encoderButton, &analog, &joystick };
+  for (EventInputBase* in : all) {
+    in->begin();
+    inputs.add(*in);
+  }
+
+  Serial.println("# InputEvents update() benchmark");
+  Serial.println("input,variant,scenario,updates,per_update,unit");
+  for (Scenario& s : scenarios) {
+    runScenario(s);
+  }
+  hc165.begin();
+  hc165Port.begin();
+  hc165Spi.begin();
+  for (ExpanderScenario& s : expanderScenarios) {
+    runExpanderScenario(s);
+  }
+  runEncoderDecoderScenarios();
+  runDividerScenarios();
+  Serial.print("# events fired: ");
+  Serial.println(eventCount);
+}
+
+void loop() {
+}
@@ -12,6 +12,7 @@
  *
  */
 #include <EventButton.h>
+#include <InputManager.h>
 
 const uint8_t buttonPin = 2;  // the number of the pushbutton pin
 const uint8_t ledPin = 13;    // the number of the LED pin
@@ -87,10 +88,13 @@ void onButtonEvent(InputEventType et, EventButton& eb) {
 EventButton myButton(buttonPin); // Create an EventButton and the default debouncer
 //EventButton myButton(buttonPin, false); // Will create an EventButton without default debouncer
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 
 void setup() {
   Serial.begin(9600);
   myButton.begin();
+  inputs.add(myButton);
   delay(500);
   Serial.println("EventButton Basic Example");
   pinMode(ledPin, OUTPUT);
@@ -99,8 +103,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventButton.
-  // This will update the state of the button and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myButton.update();
+  inputs.update();
 }
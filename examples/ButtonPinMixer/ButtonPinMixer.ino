@@ -16,6 +16,7 @@
  *
  */
 #include <EventButton.h>
+#include <InputManager.h>
 #include "PinAdapter/GpioPinAdapter.h"
 #include "PinAdapter/VirtualPinAdapter.h"
 #include "PinAdapter/PinMixerAdapter.h"
@@ -95,12 +96,15 @@ VirtualPinAdapter virtualPin; //Create gloablly so we can access it
 //Create an EventPutton with a mixed GPIO pin and a virtual pin
 EventButton myButton(new PinMixerAdapter(new GpioPinAdapter(buttonPin), &virtualPin));
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 uint32_t lastVirtualPressMs = 0; //Timer for example
 bool pressed = false; //we have virtually pressed
 
 void setup() {
   Serial.begin(9600);
   myButton.begin();
+  inputs.add(myButton);
   delay(500);
   Serial.println("EventButton Basic Example");
   pinMode(ledPin, OUTPUT);
@@ -109,10 +113,10 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventButton.
-  // This will update the state of the button and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myButton.update();
+  inputs.update();
 
   uint32_t now = millis();
   if ( now > lastVirtualPressMs + 10000 ) {
@@ -11,6 +11,7 @@
 #include <EncoderAdapter/PjrcEncoderAdapter.h> //Adapter for PJRC's Encoder
 //Then include EventEncoder
 #include <EventEncoder.h>
+#include <InputManager.h>
 
 const uint8_t encoderPin1 = 2;  //must be in interrupt pin
 const uint8_t encoderPin2 = 3;  //should be in interrupt pin
@@ -20,6 +21,8 @@ PjrcEncoderAdapter encoderAdapter(encoderPin1, encoderPin2); //Adapter for PJRC'
 //Create the EventEncoder, passing a reference to the adapter
 EventEncoder myEncoder(&encoderAdapter); //Create an EventEncoder
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 /**
  * Utility function to print the encoder events to Serial.
  * See other examples for other event types
@@ -67,6 +70,7 @@ void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   myEncoder.begin();
+  inputs.add(myEncoder);
   delay(500);
   Serial.println("EventEncoder Basic Example");
 
@@ -75,8 +79,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventEncoder.
-  // This will update the state of the encoder and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myEncoder.update();
+  inputs.update();
 }
@@ -0,0 +1,82 @@
+/**
+ * An example of EventEncoder acceleration: turn slowly for single
+ * steps, quickly to move further with each step.
+ *
+ * Holding the button locks the encoder (disables it) - turns while
+ * locked are ignored.
+ */
+
+//First include your chosen encoder library
+#include <Encoder.h> //PJRC's Encoder library
+//Then include the adapter for your chosen encoder library
+#include <EncoderAdapter/PjrcEncoderAdapter.h> //Adapter for PJRC's Encoder
+//Then include EventEncoder and EventButton
+#include <EventEncoder.h>
+#include <EventButton.h>
+#include <InputManager.h>
+
+const uint8_t encoderPin1 = 2;  //must be in interrupt pin
+const uint8_t encoderPin2 = 3;  //should be in interrupt pin
+const uint8_t lockPin = 4;
+
+//Create an encoder adapter
+PjrcEncoderAdapter encoderAdapter(encoderPin1, encoderPin2); //Adapter for PJRC's Encoder.
+//Create the EventEncoder, passing a reference to the adapter
+EventEncoder myEncoder(&encoderAdapter);
+//Hold this button to lock the encoder
+EventButton lockButton(lockPin);
+
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
+void onEncoderEvent(InputEventType et, EventEncoder& ee) {
+  switch (et) {
+  case InputEventType::ENABLED :
+    Serial.println("onEncoderEvent: ENABLED");
+    break;
+  case InputEventType::DISABLED :
+    Serial.println("onEncoderEvent: DISABLED");
+    break;
+  case InputEventType::CHANGED :
+    Serial.print("onEncoderEvent: CHANGED, increment: ");
+    Serial.print(ee.increment());
+    Serial.print(" (");
+    Serial.print(ee.rawIncrement());
+    Serial.print(" at ");
+    Serial.print(ee.velocity());
+    Serial.print(" steps/s), position: ");
+    Serial.println(ee.position());
+    break;
+  default:
+    break;
+  }
+}
+
+void onLockEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::PRESSED ) {
+    myEncoder.enable(false);
+  } else if ( et == InputEventType::RELEASED ) {
+    myEncoder.enable();
+  }
+}
+
+void setup() {
+  Serial.begin(9600);
+  myEncoder.begin();
+  lockButton.begin();
+  inputs.add(myEncoder);
+  inputs.add(lockButton);
+  delay(500);
+  Serial.println("EventEncoder Acceleration Example");
+
+  //Use the default curve (x1 to x100) - or pass your own, see docs/EventEncoder.md
+  myEncoder.setAcceleration();
+
+  //Link the event(s) to your functions
+  myEncoder.setCallback(onEncoderEvent);
+  lockButton.setCallback(onLockEvent);
+}
+
+void loop() {
+  // Update every input added to the InputManager.
+  inputs.update();
+}
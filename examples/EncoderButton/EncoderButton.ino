@@ -7,6 +7,7 @@
 #include <EncoderAdapter/PjrcEncoderAdapter.h> //Adapter for PJRC's Encoder
 //Then include EventEncoderButton
 #include <EventEncoderButton.h>
+#include <InputManager.h>
 
 const uint8_t encoderPin1 = 2;  //must be in interrupt pin
 const uint8_t encoderPin2 = 3;  //should be in interrupt pin
@@ -17,6 +18,8 @@ PjrcEncoderAdapter encoderAdapter(encoderPin1, encoderPin2); //Adapter for PJRC'
 //Create the EventEncoderButton, passing a reference to the adapter
 EventEncoderButton myEncoderButton(&encoderAdapter, buttonPin);
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 /**
  * Utility function to print the encoder button events to Serial.
  * See other examples for other event types
@@ -103,6 +106,7 @@ void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   myEncoderButton.begin();
+  inputs.add(myEncoderButton);
   delay(500);
   Serial.println("EventEncoderButton Basic Example");
 
@@ -111,8 +115,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventEncoderButton.
-  // This will update the state of the encoder button and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myEncoderButton.update();
+  inputs.update();
 }
@@ -8,9 +8,10 @@
 //First include your chosen encoder library
 #include <Encoder.h>  //PJRC's Encoder library
 //Then include the adapter for your chosen encoder library
-#include <PjrcEncoderAdapter.h> //Adapter for PJRC's Encoder
+#include <EncoderAdapter/PjrcEncoderAdapter.h> //Adapter for PJRC's Encoder
 //Then include EventEncoderButton
 #include <EventEncoderButton.h>
+#include <InputManager.h>
 
 const uint8_t encoderPin1 = 2;  //must be in interrupt pin
 const uint8_t encoderPin2 = 3;  //should be in interrupt pin
@@ -21,6 +22,8 @@ PjrcEncoderAdapter encoderAdapter(encoderPin1, encoderPin2); //Adapter for PJRC'
 //Create the EventEncoderButton, passing a reference to the adapter
 EventEncoderButton myEncoderButton(&encoderAdapter, buttonPin);
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 /**
  * Utility function to print the encoder button events to Serial.
  * See other examples for other event types
@@ -107,6 +110,7 @@ void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   myEncoderButton.begin();
+  inputs.add(myEncoderButton);
   delay(500);
   Serial.println("EventEncoderButton With Limits Example");
 
@@ -127,8 +131,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventEncoderButton.
-  // This will update the state of the encoder button and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myEncoderButton.update();
+  inputs.update();
 }
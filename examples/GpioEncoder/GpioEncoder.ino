@@ -0,0 +1,58 @@
+/**
+ * An example of using the EventEncoder with the built in
+ * GpioEncoderAdapter - no encoder library is needed.
+ *
+ * The encoder is decoded in pin change interrupts, so no steps
+ * are lost even though this loop() is slowed down by a delay().
+ */
+#include <EncoderAdapter/GpioEncoderAdapter.h>
+#include <EventEncoder.h>
+#include <InputManager.h>
+
+const uint8_t encoderPin1 = 2;  //must be an interrupt pin
+const uint8_t encoderPin2 = 3;  //must be an interrupt pin
+
+//Create an encoder adapter
+GpioEncoderAdapter encoderAdapter(encoderPin1, encoderPin2);
+
+//Create the EventEncoder, passing a reference to the adapter
+EventEncoder myEncoder(&encoderAdapter); //Create an EventEncoder
+
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
+/**
+ * A function to handle the events
+ * Can be called anything but requires InputEventType and
+ * EventEncoder& defined as parameters.
+ */
+void onEncoderEvent(InputEventType et, EventEncoder& ee) {
+  if ( et == InputEventType::CHANGED ) {
+    Serial.print("onEncoderEvent: CHANGED, increment: ");
+    Serial.print(ee.increment());
+    Serial.print(", position: ");
+    Serial.println(ee.position());
+  }
+}
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(9600);
+  myEncoder.begin();
+  inputs.add(myEncoder);
+  delay(500);
+  Serial.println("GpioEncoderAdapter Example");
+  if ( !encoderAdapter.isInterruptDriven() ) {
+    Serial.println("The encoder pins do not both have interrupts - steps may be lost!");
+  }
+
+  //Link the event(s) to your function
+  myEncoder.setCallback(onEncoderEvent);
+}
+
+void loop() {
+  // Update every input added to the InputManager.
+  inputs.update();
+  // Pretend to be busy. Without interrupts, turns faster than
+  // one step every 50ms would be lost.
+  delay(50);
+}
@@ -25,6 +25,7 @@
 
 //Include the EventEncoder
 #include <EventEncoder.h>
+#include <InputManager.h>
 
 //Create the required expander adapter:
 // AdafruitMCP23017ExpanderAdapter expanderAdapter;
@@ -41,6 +42,8 @@ ExpanderEncoderAdapter encoderAdapter(4, 5, expanderAdapter);
 
 EventEncoder eventEncoder(&encoderAdapter);
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 
 /**
  * Utility function to print the button events to Serial.
@@ -92,6 +95,7 @@ void setup() {
     // expanderAdapter.begin(<your addr>);
     
     eventEncoder.begin();
+    inputs.add(eventEncoder);
 
     eventEncoder.setCallback(onEncoderEvent);
 
@@ -101,6 +105,6 @@ void setup() {
 void loop() {
     // You must call update() to refresh the expander pin states
     expanderAdapter.update();
-    // Update the encoder to fire events as required
-    eventEncoder.update();
+    // Update the inputs to fire events as required
+    inputs.update();
 }
\ No newline at end of file
@@ -24,6 +24,7 @@
 
 // And finally, include the event encoder button itself.
 #include <EventEncoderButton.h>
+#include <InputManager.h>
 
 //Create the required expander adapter:
 RobTillaartPCF8575ExpanderAdapter expanderAdapter;
@@ -46,6 +47,8 @@ EventEncoderButton eventEncoderButton(&encoderAdapter, &pinAdapter);
 //EventEncoderButton eventEncoderButton(&encoderAdapter, new ExpanderPinAdapter(2, &expanderAdapter));
 // Or max & match, using a regular GPIO pin number or other PinAdapter
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 
 /**
  * Utility function to print the button events to Serial.
@@ -133,6 +136,7 @@ void setup() {
     expanderAdapter.begin();
     
     eventEncoderButton.begin();
+    inputs.add(eventEncoderButton);
     
     eventEncoderButton.setCallback(onEncoderButtonEvent);
 
@@ -142,6 +146,7 @@ void setup() {
 void loop() {
     // You must call update() to refresh the expander pin states
     expanderAdapter.update();
-    eventEncoderButton.update();
+    // Then update the inputs to fire events as required
+    inputs.update();
 
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
  * accurately while pressed.
  */
 #include <EventJoystick.h>
+#include <InputManager.h>
 
 const uint8_t analogPin1 = A0;;   //Change to suit your wiring, must be an analog pin
 const uint8_t analogPin2 = A1;;   //Change to suit your wiring, must be an analog pin
@@ -62,10 +63,13 @@ void onJoystickEvent(InputEventType et, EventJoystick& ea) {
 
 EventJoystick myJoystick(analogPin1, analogPin2); //Create an EventJoystick
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   myJoystick.begin();
+  inputs.add(myJoystick);
   delay(500);
   Serial.println("EventJoystick Basic Example");
   //Initialise both potentiometers at their current position - this is normally
@@ -85,8 +89,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventJoystick.
-  // This will update the state of the encoder and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  myJoystick.update();
+  inputs.update();
 }
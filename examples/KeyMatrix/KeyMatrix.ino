@@ -0,0 +1,103 @@
+/**
+ * A basic example of using the EventKeyMatrix with a 4x4 keypad.
+ *
+ * Each key connects a row pin to a column pin. No resistors are
+ * needed - the columns use the internal pullups.
+ */
+#include <EventKeyMatrix.h>
+#include <InputManager.h>
+
+const byte rowPins[] = { 2, 3, 4, 5 };      //Change to suit your wiring
+const byte columnPins[] = { 6, 7, 8, 9 };
+
+const char keyLabels[] = "123A456B789C*0#D"; //The label of each key, in key() order
+
+/**
+ * Utility function to print the key matrix events to Serial.
+ */
+void printEvent(InputEventType iet) {
+  switch (iet) {
+  case InputEventType::ENABLED :
+    Serial.print("ENABLED");
+    break;
+  case InputEventType::DISABLED :
+    Serial.print("DISABLED");
+    break;
+  case InputEventType::IDLE :
+    Serial.print("IDLE");
+    break;
+  case InputEventType::PRESSED :
+    Serial.print("PRESSED");
+    break;
+  case InputEventType::RELEASED :
+    Serial.print("RELEASED");
+    break;
+  case InputEventType::CLICKED :
+    Serial.print("CLICKED");
+    break;
+  case InputEventType::DOUBLE_CLICKED :
+    Serial.print("DOUBLE_CLICKED");
+    break;
+  case InputEventType::MULTI_CLICKED :
+    Serial.print("MULTI_CLICKED");
+    break;
+  case InputEventType::LONG_PRESS :
+    Serial.print("LONG_PRESS");
+    break;
+  case InputEventType::LONG_CLICKED :
+    Serial.print("LONG_CLICKED");
+    break;
+  default:
+    Serial.print("Unknown event: ");
+    Serial.print((uint8_t)iet);
+    break;
+  }
+}
+
+/**
+ * A function to handle the events
+ * Can be called anything but requires InputEventType and
+ * EventKeyMatrix& defined as parameters.
+ */
+void onKeyEvent(InputEventType et, EventKeyMatrix& km) {
+  Serial.print("onKeyEvent: ");
+  printEvent(et);
+  if ( km.key() != EventKeyMatrix::NO_KEY ) {
+    Serial.print(" key: ");
+    Serial.print(keyLabels[km.key()]);
+    if ( et == InputEventType::MULTI_CLICKED ) {
+      Serial.print(" clicks: ");
+      Serial.print(km.clickCount());
+    }
+  }
+  if ( km.isGhosting() ) {
+    Serial.print(" (a press is being ignored)");
+  }
+  Serial.println();
+}
+
+EventKeyMatrix keypad(rowPins, 4, columnPins, 4); //Create an EventKeyMatrix
+
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
+void setup() {
+  // put your setup code here, to run once:
+  Serial.begin(9600);
+  keypad.begin();
+  inputs.add(keypad);
+  delay(500);
+  Serial.println("EventKeyMatrix Basic Example");
+
+  //If every key has a diode, any combination of keys can be pressed
+  //keypad.setAntiGhosting(false);
+
+  //Link the event(s) to your function
+  keypad.setCallback(onKeyEvent);
+}
+
+void loop() {
+  // Update every input added to the InputManager.
+  // This will update the state of each input and
+  // fire the appropriate events.
+  inputs.update();
+}
@@ -0,0 +1,59 @@
+/**
+ * An example of sleeping between button events to save power.
+ *
+ * The InputManager only updates the button when its pin changes
+ * or a timed event (LONG_PRESS, CLICKED, IDLE etc) is due and
+ * sleeps in between. Pin changes wake the MCU via an interrupt,
+ * so the button must be on an interrupt capable pin.
+ *
+ * The button is connected between pin 2 and GND.
+ *
+ */
+#include <EventButton.h>
+#include <InputManager.h>
+#include <SleepAdapter/GpioSleepAdapter.h>
+
+const uint8_t buttonPin = 2;  // Must be an interrupt pin
+const uint8_t ledPin = 13;    // the number of the LED pin
+
+/**
+ * A function to handle the events
+ */
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  if ( et == InputEventType::PRESSED ) {
+    digitalWrite(ledPin, HIGH);
+  } else if ( et == InputEventType::RELEASED ) {
+    digitalWrite(ledPin, LOW);
+  }
+  Serial.print("onButtonEvent: ");
+  Serial.println((uint8_t)et);
+}
+
+
+EventButton myButton(buttonPin);
+
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
+GpioSleepAdapter sleeper; // Sleeps until a pin changes or the next timed event is due
+
+
+void setup() {
+  Serial.begin(9600);
+  myButton.begin();
+  inputs.add(myButton);
+  inputs.enableScheduling();
+  inputs.setSleepAdapter(&sleeper);
+  delay(500);
+  Serial.println("EventButton Low Power Example");
+  if ( !inputs.canSleep() ) {
+    Serial.println("Button pin cannot wake the MCU - not sleeping");
+  }
+  pinMode(ledPin, OUTPUT);
+  myButton.setCallback(onButtonEvent);
+}
+
+void loop() {
+  inputs.update();
+  Serial.flush(); // Finish printing before sleeping
+  inputs.sleep();
+}
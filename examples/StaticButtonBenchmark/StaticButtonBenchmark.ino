@@ -0,0 +1,94 @@
+/**
+ * Compares the cost of EventButton with StaticEventButton.
+ *
+ * Both buttons are updated 10000 times with the button released and
+ * the average CPU cycles per update() are printed (microseconds per
+ * 10000 updates on boards without a cycle counter - see CycleCounter).
+ * RAM used by each button (including EventButton's heap allocated
+ * GpioPinAdapter and FoltmanDebounceAdapter) is also printed.
+ *
+ * To compare flash, comment out one of the BENCHMARK_ defines below
+ * and note the sketch size reported when compiling.
+ *
+ * Connect buttons between pins 2 & 3 and GND.
+ *
+ */
+#define BENCHMARK_EVENT_BUTTON
+#define BENCHMARK_STATIC_EVENT_BUTTON
+
+#include <EventButton.h>
+#include <StaticEventButton.h>
+#include <CycleCounter.h>
+
+const uint16_t updates = 10000;
+
+#ifdef BENCHMARK_EVENT_BUTTON
+void onButtonEvent(InputEventType et, EventButton& eb) {
+  Serial.print("EventButton: ");
+  Serial.println((uint8_t)et);
+}
+EventButton eventButton(2);
+#endif
+
+#ifdef BENCHMARK_STATIC_EVENT_BUTTON
+/**
+ * The StaticEventButton handler is bound at compile time.
+ */
+struct StaticButtonHandler {
+  template <typename B>
+  static void onEvent(InputEventType et, B& button) {
+    Serial.print("StaticEventButton: ");
+    Serial.println((uint8_t)et);
+  }
+};
+StaticEventButton<StaticGpioPin<3>, StaticFoltmanDebouncer<10>, StaticButtonHandler> staticButton;
+#endif
+
+void printResult(const char* name, uint32_t cycles, size_t ram) {
+  Serial.print(name);
+  if ( CycleCounter::isMicros() ) {
+    Serial.print(" microseconds per ");
+    Serial.print(updates);
+    Serial.print(" updates: ");
+    Serial.print(cycles);
+  } else {
+    Serial.print(" cycles per update: ");
+    Serial.print(cycles / updates);
+  }
+  Serial.print(", RAM: ");
+  Serial.println(ram);
+}
+
+void setup() {
+  Serial.begin(9600);
+  delay(500);
+  Serial.println("EventButton vs StaticEventButton Benchmark");
+  CycleCounter::begin();
+  #ifdef BENCHMARK_EVENT_BUTTON
+  eventButton.begin();
+  eventButton.setCallback(onButtonEvent);
+  #endif
+  #ifdef BENCHMARK_STATIC_EVENT_BUTTON
+  staticButton.begin();
+  #endif
+}
+
+void loop() {
+  uint32_t start;
+  #ifdef BENCHMARK_EVENT_BUTTON
+  start = CycleCounter::read();
+  for (uint16_t i = 0; i < updates; i++) {
+    eventButton.update();
+  }
+  printResult("EventButton", CycleCounter::read() - start,
+    sizeof(EventButton) + sizeof(GpioPinAdapter) + sizeof(FoltmanDebounceAdapter));
+  #endif
+  #ifdef BENCHMARK_STATIC_EVENT_BUTTON
+  start = CycleCounter::read();
+  for (uint16_t i = 0; i < updates; i++) {
+    staticButton.update();
+  }
+  printResult("StaticEventButton", CycleCounter::read() - start, sizeof(staticButton));
+  #endif
+  delay(2000);
+}
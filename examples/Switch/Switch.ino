@@ -2,6 +2,7 @@
  * A basic example of using the EventSwitch.
  */
 #include <EventSwitch.h>
+#include <InputManager.h>
 
 const uint8_t switchPin = 2;   //Change to suit your wiring
 
@@ -47,10 +48,13 @@ void onSwitchEvent(InputEventType et, EventSwitch& es) {
 
 EventSwitch mySwitch(switchPin); //Create an EventSwitch
 
+InputManager inputs; // Updates all added inputs with a single call in loop()
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
   mySwitch.begin();
+  inputs.add(mySwitch);
   delay(500);
   Serial.println("EventSwitch Basic Example");
 
@@ -68,8 +72,8 @@ void setup() {
 }
 
 void loop() {
-  // You must call update() for every defined EventSwitch.
-  // This will update the state of the switch and 
+  // Update every input added to the InputManager.
+  // This will update the state of each input and 
   // fire the appropriate events.
-  mySwitch.update();
+  inputs.update();
 }
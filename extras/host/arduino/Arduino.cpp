@@ -0,0 +1,492 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "SPI.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+HostSerial Serial;
+TwoWire Wire;
+SPIClass SPI;
+
+namespace {
+
+    struct Interrupt {
+        void (*isr)() = nullptr;
+        int mode = CHANGE;
+    };
+
+    struct Listener {
+        uint8_t pin;
+        HostArduino::PinListener listener;
+        void* context;
+    };
+
+    struct I2CInputListener {
+        uint8_t address;
+        HostArduino::I2CListener listener;
+        void* context;
+    };
+
+    enum class ActionType : uint8_t { PIN, ANALOG, I2C, CALL };
+
+    struct Scheduled {
+        uint64_t atUs;
+        uint32_t sequence; // Keeps changes scheduled for the same time in order
+        ActionType type;
+        uint8_t target;
+        uint32_t value;
+        HostArduino::ScheduledAction action;
+        void* context;
+    };
+
+    uint64_t nowUs = 0;
+    bool level[HostArduino::MAX_PINS];
+    bool driven[HostArduino::MAX_PINS];
+    uint8_t mode[HostArduino::MAX_PINS];
+    int analogValue[HostArduino::MAX_PINS];
+    Interrupt interrupt[HostArduino::MAX_PINS];
+    uint64_t pendingInterrupts = 0;
+    bool interruptsEnabled = true;
+    Listener listeners[HostArduino::MAX_PIN_LISTENERS];
+    uint8_t listenerCount = 0;
+    uint16_t i2cInputs[128];
+    uint8_t i2cInterruptPin[128];
+    I2CInputListener i2cListeners[HostArduino::MAX_I2C_LISTENERS];
+    uint8_t i2cListenerCount = 0;
+    uint32_t i2cReads = 0;
+    std::vector<Scheduled> scheduled;
+    uint32_t scheduleSequence = 0;
+
+    struct Init { Init() { HostArduino::reset(); } } init;
+
+    uint32_t nowMs() { return (uint32_t)(nowUs / 1000); }
+
+    bool isTriggered(int mode, bool level) {
+        switch (mode) {
+        case RISING: return level;
+        case FALLING: return !level;
+        default: return true; // CHANGE
+        }
+    }
+
+    void notifyListeners(uint8_t pin) {
+        for (uint8_t i = 0; i < listenerCount; i++) {
+            if ( listeners[i].pin == pin ) listeners[i].listener(pin, listeners[i].context);
+        }
+    }
+
+    void setLevel(uint8_t pin, bool newLevel) {
+        if ( pin >= HostArduino::MAX_PINS || level[pin] == newLevel ) return;
+        level[pin] = newLevel;
+        notifyListeners(pin);
+        if ( interrupt[pin].isr && isTriggered(interrupt[pin].mode, newLevel) ) {
+            if ( interruptsEnabled ) {
+                interrupt[pin].isr();
+            } else {
+                pendingInterrupts |= (1ULL << pin);
+            }
+        }
+    }
+
+    bool addScheduled(uint32_t atMs, ActionType type, uint8_t target, uint32_t value,
+                      HostArduino::ScheduledAction action = nullptr, void* context = nullptr) {
+        int32_t aheadMs = (int32_t)(atMs - nowMs()); // Safe across millis() rollover
+        if ( aheadMs < 0 ) aheadMs = 0;
+        Scheduled s = { nowUs - (nowUs % 1000) + (uint64_t)aheadMs * 1000, scheduleSequence++, type, target, value, action, context };
+        scheduled.push_back(s);
+        return true;
+    }
+
+    void apply(const Scheduled& s) {
+        switch (s.type) {
+        case ActionType::PIN: HostArduino::setPin(s.target, s.value != 0); break;
+        case ActionType::ANALOG: HostArduino::setAnalog(s.target, (int)s.value); break;
+        case ActionType::I2C: HostArduino::setI2CInputs(s.target, (uint16_t)s.value); break;
+        case ActionType::CALL: s.action(s.context, s.value); break;
+        }
+    }
+
+    void advanceTo(uint64_t targetUs) {
+        while ( true ) {
+            size_t next = scheduled.size();
+            for (size_t i = 0; i < scheduled.size(); i++) {
+                if ( scheduled[i].atUs > targetUs ) continue;
+                if ( next == scheduled.size()
+                     || scheduled[i].atUs < scheduled[next].atUs
+                     || (scheduled[i].atUs == scheduled[next].atUs && scheduled[i].sequence < scheduled[next].sequence) ) {
+                    next = i;
+                }
+            }
+            if ( next == scheduled.size() ) break;
+            Scheduled s = scheduled[next];
+            scheduled.erase(scheduled.begin() + next);
+            if ( s.atUs > nowUs ) nowUs = s.atUs;
+            apply(s);
+        }
+        nowUs = targetUs;
+    }
+
+}
+
+/*
+ * The Arduino API
+ */
+
+unsigned long millis() { return nowMs(); }
+
+unsigned long micros() { return (uint32_t)nowUs; }
+
+void delay(unsigned long ms) { HostArduino::advanceMillis((uint32_t)ms); }
+
+void delayMicroseconds(unsigned int us) { HostArduino::advanceMicros(us); }
+
+void yield() {}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+void pinMode(uint8_t pin, uint8_t newMode) {
+    if ( pin >= HostArduino::MAX_PINS ) return;
+    bool changed = mode[pin] != newMode;
+    mode[pin] = newMode;
+    if ( !driven[pin] && newMode != OUTPUT ) level[pin] = (newMode == INPUT_PULLUP);
+    if ( changed ) notifyListeners(pin); // eg a key matrix row switching between driven and floating
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < HostArduino::MAX_PINS && level[pin] ? HIGH : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    setLevel(pin, value != LOW);
+}
+
+int analogRead(uint8_t pin) {
+    return pin < HostArduino::MAX_PINS ? analogValue[pin] : 0;
+}
+
+void analogReadResolution(int bits) {}
+
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int interruptMode) {
+    if ( interruptNum >= HostArduino::MAX_PINS ) return;
+    interrupt[interruptNum].isr = isr;
+    interrupt[interruptNum].mode = interruptMode;
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+    if ( interruptNum >= HostArduino::MAX_PINS ) return;
+    interrupt[interruptNum].isr = nullptr;
+    pendingInterrupts &= ~(1ULL << interruptNum);
+}
+
+void noInterrupts() { interruptsEnabled = false; }
+
+bool interruptsAreEnabled() { return interruptsEnabled; }
+
+void interrupts() {
+    interruptsEnabled = true;
+    while ( pendingInterrupts ) {
+        uint8_t pin = __builtin_ctzll(pendingInterrupts);
+        pendingInterrupts &= ~(1ULL << pin);
+        if ( interrupt[pin].isr ) interrupt[pin].isr();
+    }
+}
+
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder) {
+    uint8_t value = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        digitalWrite(clockPin, HIGH);
+        if ( bitOrder == LSBFIRST ) {
+            value |= digitalRead(dataPin) << i;
+        } else {
+            value |= digitalRead(dataPin) << (7 - i);
+        }
+        digitalWrite(clockPin, LOW);
+    }
+    return value;
+}
+
+/*
+ * Serial
+ */
+
+void HostSerial::flush() { fflush(stdout); }
+
+size_t HostSerial::print(const char* s) { return (size_t)printf("%s", s); }
+
+size_t HostSerial::print(char c) { return putchar(c) == EOF ? 0 : 1; }
+
+size_t HostSerial::print(long n, int base) {
+    if ( base == DEC ) return (size_t)printf("%ld", n);
+    return print((unsigned long)n, base);
+}
+
+size_t HostSerial::print(unsigned long n, int base) {
+    if ( base == DEC ) return (size_t)printf("%lu", n);
+    if ( base == HEX ) return (size_t)printf("%lX", n);
+    if ( base == OCT ) return (size_t)printf("%lo", n);
+    char buf[sizeof(unsigned long) * 8 + 1];
+    char* p = &buf[sizeof(buf) - 1];
+    *p = '\0';
+    do {
+        *--p = (char)('0' + (n % base));
+        n /= base;
+    } while ( n );
+    return print(p);
+}
+
+size_t HostSerial::print(double n, int digits) { return (size_t)printf("%.*f", digits, n); }
+
+/*
+ * HostArduino
+ */
+
+void HostArduino::reset() {
+    nowUs = 0;
+    for (uint8_t pin = 0; pin < MAX_PINS; pin++) {
+        level[pin] = LOW;
+        driven[pin] = false;
+        mode[pin] = INPUT;
+        analogValue[pin] = 0;
+        interrupt[pin] = Interrupt();
+    }
+    pendingInterrupts = 0;
+    ::interruptsEnabled = true;
+    listenerCount = 0;
+    for (uint8_t i = 0; i < 128; i++) {
+        i2cInputs[i] = 0xFFFF;
+        i2cInterruptPin[i] = NO_PIN;
+    }
+    i2cListenerCount = 0;
+    i2cReads = 0;
+    scheduled.clear();
+}
+
+void HostArduino::setMillis(uint32_t ms) { nowUs = (uint64_t)ms * 1000; }
+
+void HostArduino::advanceMillis(uint32_t ms) { advanceTo(nowUs + (uint64_t)ms * 1000); }
+
+void HostArduino::advanceMicros(uint32_t us) { advanceTo(nowUs + us); }
+
+uint32_t HostArduino::cycleCount() {
+    #if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+    #else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    #endif
+}
+
+void HostArduino::setPin(uint8_t pin, bool pinLevel) {
+    if ( pin >= MAX_PINS ) return;
+    driven[pin] = true;
+    setLevel(pin, pinLevel);
+}
+
+bool HostArduino::getPin(uint8_t pin) { return pin < MAX_PINS && level[pin]; }
+
+
+uint8_t HostArduino::getPinMode(uint8_t pin) { return pin < MAX_PINS ? mode[pin] : INPUT; }
+
+void HostArduino::setAnalog(uint8_t pin, int value) {
+    if ( pin < MAX_PINS ) analogValue[pin] = value;
+}
+
+void HostArduino::setI2CInputs(uint8_t address, uint16_t value) {
+    address &= 0x7F;
+    if ( i2cInputs[address] == value ) return;
+    i2cInputs[address] = value;
+    for (uint8_t i = 0; i < i2cListenerCount; i++) {
+        if ( i2cListeners[i].address == address ) i2cListeners[i].listener(address, i2cListeners[i].context);
+    }
+}
+
+uint16_t HostArduino::getI2CInputs(uint8_t address) { return i2cInputs[address & 0x7F]; }
+
+void HostArduino::setI2CInterruptPin(uint8_t address, uint8_t pin) { i2cInterruptPin[address & 0x7F] = pin; }
+
+uint8_t HostArduino::getI2CInterruptPin(uint8_t address) { return i2cInterruptPin[address & 0x7F]; }
+
+void HostArduino::countI2CRead() { i2cReads++; }
+
+uint32_t HostArduino::i2cReadCount() { return i2cReads; }
+
+bool HostArduino::schedulePin(uint32_t atMs, uint8_t pin, bool pinLevel) {
+    return pin < MAX_PINS && addScheduled(atMs, ActionType::PIN, pin, pinLevel);
+}
+
+bool HostArduino::scheduleAnalog(uint32_t atMs, uint8_t pin, int value) {
+    return pin < MAX_PINS && addScheduled(atMs, ActionType::ANALOG, pin, (uint32_t)value);
+}
+
+bool HostArduino::scheduleI2CInputs(uint32_t atMs, uint8_t address, uint16_t value) {
+    return addScheduled(atMs, ActionType::I2C, address & 0x7F, value);
+}
+
+bool HostArduino::schedule(uint32_t atMs, ScheduledAction action, void* context, uint32_t value) {
+    return action && addScheduled(atMs, ActionType::CALL, 0, value, action, context);
+}
+
+uint16_t HostArduino::scheduledCount() { return (uint16_t)::scheduled.size(); }
+
+bool HostArduino::addPinListener(uint8_t pin, PinListener listener, void* context) {
+    if ( pin >= MAX_PINS || listenerCount >= MAX_PIN_LISTENERS ) return false;
+    listeners[listenerCount++] = { pin, listener, context };
+    return true;
+}
+
+void HostArduino::removePinListeners(void* context) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < listenerCount; i++) {
+        if ( listeners[i].context != context ) listeners[kept++] = listeners[i];
+    }
+    listenerCount = kept;
+}
+
+bool HostArduino::addI2CListener(uint8_t address, I2CListener listener, void* context) {
+    if ( i2cListenerCount >= MAX_I2C_LISTENERS ) return false;
+    i2cListeners[i2cListenerCount++] = { (uint8_t)(address & 0x7F), listener, context };
+    return true;
+}
+
+void HostArduino::removeI2CListeners(void* context) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < i2cListenerCount; i++) {
+        if ( i2cListeners[i].context != context ) i2cListeners[kept++] = i2cListeners[i];
+    }
+    i2cListenerCount = kept;
+}
+
+/*
+ * Host74HC165
+ */
+
+Host74HC165::Host74HC165(uint8_t dataPin, uint8_t clockPin, uint8_t shldPin, uint8_t cascadeLength /*=1*/)
+    : dataPin(dataPin), clockPin(clockPin), shldPin(shldPin),
+      length(cascadeLength < 1 ? 1 : (cascadeLength > MAX_LENGTH ? MAX_LENGTH : cascadeLength)) {
+    for (uint8_t w = 0; w < WORDS; w++) {
+        inputs[w] = shifter[w] = 0xFFFFFFFF;
+    }
+    HostArduino::addPinListener(clockPin, &onPinChange, this);
+    HostArduino::addPinListener(shldPin, &onPinChange, this);
+    HostArduino::setPin(dataPin, shifter[0] & 1);
+}
+
+Host74HC165::~Host74HC165() {
+    HostArduino::removePinListeners(this);
+}
+
+void Host74HC165::setInputs(uint32_t value, uint8_t word /*=0*/) {
+    if ( word >= WORDS ) return;
+    inputs[word] = value;
+    if ( !HostArduino::getPin(shldPin) ) {
+        // The parallel inputs are loaded for as long as SH/LD is LOW
+        load();
+        HostArduino::setPin(dataPin, shifter[0] & 1);
+    }
+}
+
+void Host74HC165::load() {
+    for (uint8_t w = 0; w < WORDS; w++) {
+        shifter[w] = inputs[w];
+    }
+}
+
+void Host74HC165::shift() {
+    // Shift towards Q7 of the first 74HC165, the serial input (DS) of the last is pulled high
+    uint8_t last = (length * 8 - 1) / 32;
+    for (uint8_t w = 0; w <= last; w++) {
+        uint32_t carry = w < last ? (shifter[w + 1] & 1) : 1;
+        shifter[w] = (shifter[w] >> 1) | (carry << 31);
+    }
+    uint8_t top = (length * 8 - 1) % 32;
+    if ( top < 31 ) {
+        shifter[last] = (shifter[last] & ~(0xFFFFFFFFu << top)) | (1u << top);
+    }
+}
+
+void Host74HC165::onPinChange(uint8_t pin, void* context) {
+    Host74HC165* sr = static_cast<Host74HC165*>(context);
+    bool shld = HostArduino::getPin(sr->shldPin);
+    if ( pin == sr->shldPin && !shld ) {
+        // Parallel load
+        sr->load();
+    } else if ( pin == sr->clockPin && HostArduino::getPin(sr->clockPin) && shld ) {
+        sr->shift();
+    } else {
+        return;
+    }
+    HostArduino::setPin(sr->dataPin, sr->shifter[0] & 1);
+}
+
+HostKeyMatrix::HostKeyMatrix(uint8_t firstRowPin, uint8_t rowCount, uint8_t firstColumnPin, uint8_t columnCount)
+    : firstRowPin(firstRowPin),
+      rows(rowCount > MAX_ROWS ? MAX_ROWS : rowCount),
+      firstColumnPin(firstColumnPin),
+      columns(columnCount > 32 ? 32 : columnCount)
+    {
+    for (uint8_t r = 0; r < rows; r++) {
+        HostArduino::addPinListener(firstRowPin + r, &onPinChange, this);
+    }
+    updateColumns();
+}
+
+HostKeyMatrix::~HostKeyMatrix() {
+    HostArduino::removePinListeners(this);
+}
+
+void HostKeyMatrix::setKey(uint16_t key, bool pressed) {
+    if ( key >= (uint16_t)rows * columns ) return;
+    uint32_t bit = 1UL << (key % columns);
+    if ( pressed ) {
+        keys[key / columns] |= bit;
+    } else {
+        keys[key / columns] &= ~bit;
+    }
+    updateColumns();
+}
+
+bool HostKeyMatrix::getKey(uint16_t key) {
+    return key < (uint16_t)rows * columns && (keys[key / columns] >> (key % columns)) & 1;
+}
+
+void HostKeyMatrix::updateColumns() {
+    // Follow the pressed keys from the driven rows to their columns and on to other rows until nothing new is reached
+    uint32_t reachedRows = 0;
+    for (uint8_t r = 0; r < rows; r++) {
+        uint8_t pin = firstRowPin + r;
+        if ( HostArduino::getPinMode(pin) == OUTPUT && !HostArduino::getPin(pin) ) reachedRows |= 1UL << r;
+    }
+    uint32_t low = 0;
+    uint32_t previous;
+    do {
+        previous = low;
+        for (uint8_t r = 0; r < rows; r++) {
+            if ( (reachedRows >> r) & 1 ) low |= keys[r];
+        }
+        for (uint8_t r = 0; r < rows; r++) {
+            if ( keys[r] & low ) reachedRows |= 1UL << r;
+        }
+    } while ( low != previous );
+    for (uint8_t c = 0; c < columns; c++) {
+        HostArduino::setPin(firstColumnPin + c, !((low >> c) & 1));
+    }
+}
+
+void HostKeyMatrix::onPinChange(uint8_t, void* context) {
+    static_cast<HostKeyMatrix*>(context)->updateColumns();
+}
@@ -0,0 +1,141 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_ARDUINO_H
+#define INPUT_EVENTS_HOST_ARDUINO_H
+
+/*
+ * A minimal Arduino compatibility layer so InputEvents can be built and run on a
+ * desktop (Linux) host. Only the parts of the Arduino API used by the library and
+ * its examples are provided. Time, pins and the ADC are virtual and are driven
+ * from HostArduino (see HostArduino.h).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define ARDUINO 10819
+#define INPUT_EVENTS_HOST 1
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x0
+#define OUTPUT         0x1
+#define INPUT_PULLUP   0x2
+#define INPUT_PULLDOWN 0x3
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define NUM_DIGITAL_PINS 64
+#define NUM_ANALOG_INPUTS 8
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A4 58
+#define A5 59
+#define A6 60
+#define A7 61
+#define LED_BUILTIN 13
+
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) < NUM_DIGITAL_PINS ? (p) : NOT_AN_INTERRUPT)
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitToggle(value, bit) ((value) ^= (1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+#define F(s) (s)
+
+template <class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template <class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+void analogReadResolution(int bits);
+
+void attachInterrupt(uint8_t interruptNum, void (*isr)(), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void noInterrupts();
+void interrupts();
+
+/**
+ * @brief Returns false while noInterrupts() is in effect. Boards read this from a status register (eg SREG), the host
+ * provides it to InterruptLock through INPUT_EVENTS_INTERRUPTS_ENABLED().
+ */
+bool interruptsAreEnabled();
+#define INPUT_EVENTS_INTERRUPTS_ENABLED() interruptsAreEnabled()
+
+uint8_t shiftIn(uint8_t dataPin, uint8_t clockPin, uint8_t bitOrder);
+
+/**
+ * @brief Serial output on the host goes to stdout.
+ */
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    void flush();
+    operator bool() const { return true; }
+
+    size_t print(const char* s);
+    size_t print(char c);
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(long long n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(double n, int digits = 2);
+
+    size_t println() { return print('\n'); }
+    template <typename T>
+    size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T>
+    size_t println(T v, int format) { size_t n = print(v, format); return n + println(); }
+};
+
+extern HostSerial Serial;
+
+#include "HostArduino.h"
+
+#endif
@@ -0,0 +1,243 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_HOST_ARDUINO_H
+#define INPUT_EVENTS_HOST_HOST_ARDUINO_H
+
+#include <stdint.h>
+
+/**
+ * @brief Control of the virtual 'hardware' behind the host Arduino shim.
+ *
+ * @details The clock only moves when it is advanced (or when the sketch calls delay()), so runs are repeatable.
+ * Pin, ADC and I2C expander changes can be applied immediately or scheduled for a time, in which case they are
+ * applied as the clock passes that time.
+ *
+ * Pins with INPUT_PULLUP read HIGH until they are set, all other pins read LOW. I2C expander inputs read 0xFFFF
+ * (all pulled up) until they are set.
+ */
+class HostArduino {
+
+public:
+
+    /**
+     * @brief Called when the level of a pin changes (set by setPin() or written by the sketch) or pinMode() changes
+     * its mode.
+     */
+    typedef void (*PinListener)(uint8_t pin, void* context);
+
+    /**
+     * @brief Called when the inputs of an I2C expander change (see setI2CInputs()).
+     */
+    typedef void (*I2CListener)(uint8_t address, void* context);
+
+    /**
+     * @brief A scheduled change, see schedule().
+     */
+    typedef void (*ScheduledAction)(void* context, uint32_t value);
+
+    static const uint8_t MAX_PINS = 64;
+    static const uint8_t MAX_PIN_LISTENERS = 16;
+    static const uint8_t MAX_I2C_LISTENERS = 8;
+    static const uint8_t NO_PIN = 0xFF;
+
+    /**
+     * @brief Reset the clock, pins, interrupts, I2C devices and schedule.
+     */
+    static void reset();
+
+    /**
+     * @brief Set the clock. Scheduled changes before this time are *not* applied.
+     */
+    static void setMillis(uint32_t ms);
+
+    /**
+     * @brief Advance the clock, applying scheduled changes in time order.
+     */
+    static void advanceMillis(uint32_t ms);
+
+    /**
+     * @brief Advance the clock, applying scheduled changes in time order.
+     */
+    static void advanceMicros(uint32_t us);
+
+    /**
+     * @brief The real (not virtual) CPU cycle counter, used by CycleCounter. The x86 TSC, or nanoseconds elsewhere.
+     */
+    static uint32_t cycleCount();
+
+    /**
+     * @brief Drive an input pin. Fires any interrupt attached to the pin.
+     */
+    static void setPin(uint8_t pin, bool level);
+
+    /**
+     * @brief Returns the current level of a pin (including pins written by the sketch).
+     */
+    static bool getPin(uint8_t pin);
+
+    /**
+     * @brief Returns the mode last set by pinMode().
+     */
+    static uint8_t getPinMode(uint8_t pin);
+
+    /**
+     * @brief Set the value returned by analogRead().
+     */
+    static void setAnalog(uint8_t pin, int value);
+
+    /**
+     * @brief Set the input pins of the I2C expander at address.
+     */
+    static void setI2CInputs(uint8_t address, uint16_t value);
+
+    /**
+     * @brief Returns the input pins of the I2C expander at address.
+     */
+    static uint16_t getI2CInputs(uint8_t address);
+
+    /**
+     * @brief Connect the INT line of the I2C expander at address to a pin (or NO_PIN). The expander mocks drive the
+     * pin once their interrupts are set up.
+     */
+    static void setI2CInterruptPin(uint8_t address, uint8_t pin);
+
+    /**
+     * @brief Returns the pin connected to the INT line of the I2C expander at address (or NO_PIN).
+     */
+    static uint8_t getI2CInterruptPin(uint8_t address);
+
+    /**
+     * @brief Called by the I2C expander mocks for each bus read, see i2cReadCount().
+     */
+    static void countI2CRead();
+
+    /**
+     * @brief The number of I2C reads made by the expander mocks since reset().
+     */
+    static uint32_t i2cReadCount();
+
+    /**
+     * @brief Schedule setPin() at a time in milliseconds.
+     */
+    static bool schedulePin(uint32_t atMs, uint8_t pin, bool level);
+
+    /**
+     * @brief Schedule setAnalog() at a time in milliseconds.
+     */
+    static bool scheduleAnalog(uint32_t atMs, uint8_t pin, int value);
+
+    /**
+     * @brief Schedule setI2CInputs() at a time in milliseconds.
+     */
+    static bool scheduleI2CInputs(uint32_t atMs, uint8_t address, uint16_t value);
+
+    /**
+     * @brief Schedule a call to action(context, value) at a time in milliseconds, eg to drive a Host74HC165.
+     */
+    static bool schedule(uint32_t atMs, ScheduledAction action, void* context, uint32_t value);
+
+    /**
+     * @brief The number of scheduled changes not yet applied.
+     */
+    static uint16_t scheduledCount();
+
+    /**
+     * @brief Listen for level changes on a pin, eg to model a peripheral. Listeners are not blocked by noInterrupts().
+     */
+    static bool addPinListener(uint8_t pin, PinListener listener, void* context);
+
+    /**
+     * @brief Remove all listeners with context.
+     */
+    static void removePinListeners(void* context);
+
+    /**
+     * @brief Listen for changes to the inputs of the I2C expander at address, eg to model its INT line.
+     */
+    static bool addI2CListener(uint8_t address, I2CListener listener, void* context);
+
+    /**
+     * @brief Remove all I2C listeners with context.
+     */
+    static void removeI2CListeners(void* context);
+
+};
+
+/**
+ * @brief A model of a cascade of 74HC165 parallel in, serial out shift registers driven by the sketch's pins.
+ *
+ * @details The parallel inputs are loaded while SH/LD is LOW and shifted to the data pin on each rising clock edge.
+ * A cascade can be up to MAX_LENGTH (32) 74HC165s long.
+ */
+class Host74HC165 {
+
+public:
+
+    static constexpr uint8_t MAX_LENGTH = 32;
+
+    Host74HC165(uint8_t dataPin, uint8_t clockPin, uint8_t shldPin, uint8_t cascadeLength = 1);
+    ~Host74HC165();
+
+    /**
+     * @brief Set 32 of the parallel inputs. Bit 0 of word 0 is the first bit shifted out, bit 0 of word 1 the 33rd.
+     */
+    void setInputs(uint32_t value, uint8_t word = 0);
+
+    uint32_t getInputs(uint8_t word = 0) { return word < WORDS ? inputs[word] : 0xFFFFFFFF; }
+
+private:
+    static constexpr uint8_t WORDS = MAX_LENGTH / 4;
+
+    uint8_t dataPin;
+    uint8_t clockPin;
+    uint8_t shldPin;
+    uint8_t length;
+    uint32_t inputs[WORDS];
+    uint32_t shifter[WORDS];
+
+    void load();
+    void shift();
+    static void onPinChange(uint8_t pin, void* context);
+};
+
+/**
+ * @brief A model of a key matrix (without diodes) on consecutive row and column pins.
+ *
+ * @details A row is driven while the sketch has it as an OUTPUT and LOW. Each column reads LOW while it is connected
+ * to a driven row through pressed keys - including through other rows, so three keys on the corners of a rectangle
+ * also connect the fourth corner (a ghost). Columns are HIGH (pulled up) otherwise.
+ */
+class HostKeyMatrix {
+
+public:
+
+    static constexpr uint8_t MAX_ROWS = 32;
+
+    HostKeyMatrix(uint8_t firstRowPin, uint8_t rowCount, uint8_t firstColumnPin, uint8_t columnCount);
+    ~HostKeyMatrix();
+
+    /**
+     * @brief Press or release a key (row * columnCount + column).
+     */
+    void setKey(uint16_t key, bool pressed);
+
+    bool getKey(uint16_t key);
+
+private:
+    uint8_t firstRowPin;
+    uint8_t rows;
+    uint8_t firstColumnPin;
+    uint8_t columns;
+    uint32_t keys[MAX_ROWS] = {}; ///< The pressed keys of each row, one bit per column
+
+    void updateColumns();
+    static void onPinChange(uint8_t pin, void* context);
+};
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_SPI_H
+#define INPUT_EVENTS_HOST_SPI_H
+
+#include "Arduino.h"
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+static const uint8_t SS   = 53;
+static const uint8_t MOSI = 51;
+static const uint8_t MISO = 50;
+static const uint8_t SCK  = 52;
+
+class SPISettings {
+public:
+    SPISettings() {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+        : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+    uint32_t clock = 4000000;
+    uint8_t bitOrder = MSBFIRST;
+    uint8_t dataMode = SPI_MODE0;
+};
+
+/*
+ * A minimal Arduino SPI library. Transfers are clocked out (mode 0 only) on the SCK
+ * and MOSI pins and sampled from MISO, so a peripheral model such as Host74HC165 on
+ * those pins sees the same edges as a bit-banged read. Transfers take no virtual time.
+ */
+class SPIClass {
+public:
+    void begin() {
+        pinMode(SCK, OUTPUT);
+        pinMode(MOSI, OUTPUT);
+        pinMode(MISO, INPUT);
+        digitalWrite(SCK, LOW);
+    }
+    void end() {}
+    void beginTransaction(SPISettings s) { settings = s; }
+    void endTransaction() {}
+    uint8_t transfer(uint8_t out) {
+        uint8_t in = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+            uint8_t bit = settings.bitOrder == LSBFIRST ? i : 7 - i;
+            digitalWrite(MOSI, (out >> bit) & 1);
+            in |= (uint8_t)digitalRead(MISO) << bit; // Sampled on the rising edge
+            digitalWrite(SCK, HIGH);
+            digitalWrite(SCK, LOW);
+        }
+        transferred++;
+        return in;
+    }
+    void transfer(void* buffer, size_t count) {
+        uint8_t* bytes = static_cast<uint8_t*>(buffer);
+        for (size_t i = 0; i < count; i++) {
+            bytes[i] = transfer(bytes[i]);
+        }
+    }
+    /**
+     * @brief The number of bytes transferred since the start of the run.
+     */
+    uint32_t transferCount() { return transferred; }
+
+private:
+    SPISettings settings;
+    uint32_t transferred = 0;
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_WIRE_H
+#define INPUT_EVENTS_HOST_WIRE_H
+
+#include "Arduino.h"
+
+/*
+ * A minimal Arduino Wire library. requestFrom() returns the inputs of the host I2C
+ * expander at the address (HostArduino::getI2CInputs(), low byte first) and counts a
+ * read. Writes are ignored. The I2C expander mocks (in extras/host/libraries) do not
+ * use it.
+ */
+class TwoWire {
+public:
+    void begin() {}
+    void end() {}
+    void setClock(uint32_t) {}
+    void beginTransmission(uint8_t) {}
+    uint8_t endTransmission(bool = true) { return 0; }
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, bool = true) {
+        HostArduino::countI2CRead();
+        rxInputs = HostArduino::getI2CInputs(address) | 0xFFFF0000;
+        rxLength = quantity > 4 ? 4 : quantity;
+        rxPosition = 0;
+        return rxLength;
+    }
+    size_t write(uint8_t) { return 1; }
+    int available() { return rxLength - rxPosition; }
+    int read() { return rxPosition < rxLength ? (uint8_t)(rxInputs >> (8 * rxPosition++)) : -1; }
+
+private:
+    uint32_t rxInputs = 0xFFFFFFFF;
+    uint8_t rxLength = 0;
+    uint8_t rxPosition = 0;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,92 @@
+/**
+ * Check: AsyncI2CExpanderAdapter on a (host) non-blocking bus.
+ *
+ * - update() starts a read and returns, a later update() collects it once the transfer has finished.
+ * - Pin states, changedMask() and sampleAgeMs() are from the last completed read.
+ * - Adapters sharing a bus take turns and a failed read keeps the previous pin states.
+ */
+
+#include <Arduino.h>
+#include <GpioExpanderAdapter/AsyncI2CExpanderAdapter.h>
+#include <HostAsyncI2CBus.h>
+#include "Check.h"
+
+namespace {
+
+void checkReads() {
+    HostArduino::reset();
+    HostAsyncI2CBus bus(300);
+    AsyncI2CExpanderAdapter expander(bus, 0x20, 16);
+    HostArduino::setI2CInputs(0x20, 0xFFFE);
+    expander.begin();
+    CHECK(expander.hasSample());
+    CHECK_EQUAL(expander.readAll(), 0xFFFE);
+    CHECK_EQUAL(expander.changedMask(), 0);
+
+    //The read is started, but not finished, by this update
+    HostArduino::setI2CInputs(0x20, 0xFFFF);
+    uint32_t startUs = micros();
+    expander.update();
+    CHECK_EQUAL(micros(), startUs);
+    CHECK_EQUAL(expander.readAll(), 0xFFFE);
+    HostArduino::advanceMicros(200);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFE);
+    CHECK_EQUAL(expander.changedMask(), 0);
+    HostArduino::advanceMicros(100);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+    CHECK_EQUAL(expander.changedMask(), bit(0));
+
+    //The sample is as old as the start of its read
+    uint32_t sampleMs = expander.sampleTimeMs();
+    HostArduino::advanceMillis(5);
+    CHECK_EQUAL(expander.sampleAgeMs(), millis() - sampleMs);
+    CHECK(expander.sampleAgeMs() >= 5);
+
+    //A failed read is counted and keeps the last pin states
+    bus.failNext();
+    HostArduino::setI2CInputs(0x20, 0x0000);
+    expander.update();
+    HostArduino::advanceMicros(300);
+    expander.update();
+    CHECK_EQUAL(expander.failedReads(), 1);
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+    CHECK_EQUAL(expander.changedMask(), 0);
+}
+
+void checkSharedBus() {
+    HostArduino::reset();
+    HostAsyncI2CBus bus(300);
+    AsyncI2CExpanderAdapter expander1(bus, 0x20, 16);
+    AsyncI2CExpanderAdapter expander2(bus, 0x21, 8);
+    HostArduino::setI2CInputs(0x20, 0x1234);
+    HostArduino::setI2CInputs(0x21, 0x0056);
+    expander1.begin();
+    expander2.begin();
+    CHECK_EQUAL(expander1.readAll(), 0x1234);
+    CHECK_EQUAL(expander2.readAll(), 0x56);
+
+    //Updated every 100us, each read takes 300us and neither adapter may starve the other
+    HostArduino::setI2CInputs(0x20, 0x4321);
+    HostArduino::setI2CInputs(0x21, 0x0065);
+    uint32_t transfers = bus.transferCount();
+    for (uint8_t i = 0; i < 20; i++) {
+        expander1.update();
+        expander2.update();
+        HostArduino::advanceMicros(100);
+    }
+    CHECK_EQUAL(expander1.readAll(), 0x4321);
+    CHECK_EQUAL(expander2.readAll(), 0x65);
+    CHECK(bus.transferCount() - transfers >= 4);
+    CHECK_EQUAL(expander1.failedReads(), 0);
+    CHECK_EQUAL(expander2.failedReads(), 0);
+}
+
+}
+
+int main() {
+    checkReads();
+    checkSharedBus();
+    return checkResult();
+}
@@ -0,0 +1,198 @@
+/**
+ * Check: ExpanderBusScheduler.
+ *
+ * - Each pass reads the due expanders highest priority first, then in the order they were added.
+ * - Each expander is read at its own interval (across a millis() rollover) and nextReadMs() is the earliest of them.
+ * - With a bus budget the highest priority due expander is always read and the rest are deferred, not dropped.
+ * - A ScheduledExpanderAdapter's changedMask() holds the changes from the scheduler's reads since its last update().
+ */
+
+#include <Arduino.h>
+#include <GpioExpanderAdapter/ExpanderBusScheduler.h>
+#include <string>
+#include "Check.h"
+
+namespace {
+
+std::string readLog;
+
+/**
+ * An expander that logs its reads, each taking readUs on the (host) bus.
+ */
+class TestExpanderAdapter : public GpioExpanderAdapter {
+public:
+    TestExpanderAdapter(char name, uint16_t readUs = 100) : name(name), readUs(readUs) {}
+    void begin() override {}
+    void update() override {
+        readLog += name;
+        HostArduino::advanceMicros(readUs);
+        changedBits = pins ^ previous;
+        previous = pins;
+    }
+    bool read(byte pin) override { return bitRead(previous, pin); }
+    uint32_t readAll() override { return previous; }
+    uint32_t changedMask() override { return changedBits; }
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+    uint32_t pins = 0;
+private:
+    char name;
+    uint16_t readUs;
+    uint32_t previous = 0;
+    uint32_t changedBits = 0;
+};
+
+void checkOrder() {
+    HostArduino::reset();
+    readLog.clear();
+    TestExpanderAdapter a('a'), b('b'), c('c'), d('d');
+    ScheduledExpanderAdapter low1(a, 0, 0);
+    ScheduledExpanderAdapter high(b, 0, 10);
+    ScheduledExpanderAdapter low2(c, 0, 0);
+    ScheduledExpanderAdapter mid(d, 0, 5);
+    ExpanderBusScheduler bus;
+    CHECK(bus.add(low1));
+    CHECK(bus.add(high));
+    CHECK(bus.add(low2));
+    CHECK(bus.add(mid));
+    CHECK(!bus.add(mid));
+    CHECK_EQUAL(bus.count(), 4);
+    bus.begin();
+    CHECK(readLog == "bdac");
+    readLog.clear();
+    CHECK_EQUAL(bus.update(), 4);
+    CHECK(readLog == "bdac");
+    readLog.clear();
+    CHECK(bus.remove(mid));
+    CHECK(!bus.remove(mid));
+    CHECK_EQUAL(bus.update(), 3);
+    CHECK(readLog == "bac");
+}
+
+void checkIntervals(uint32_t startMs) {
+    HostArduino::reset();
+    HostArduino::setMillis(startMs);
+    TestExpanderAdapter a('a'), b('b'), c('c');
+    ScheduledExpanderAdapter fast(a, 1, 10);
+    ScheduledExpanderAdapter medium(b, 5);
+    ScheduledExpanderAdapter slow(c, 20);
+    ExpanderBusScheduler bus;
+    bus.add(slow);
+    bus.add(medium);
+    bus.add(fast);
+    bus.begin();
+    //The model: when each is next due, in the order they are read
+    ScheduledExpanderAdapter* expanders[] = { &fast, &slow, &medium };
+    const char names[] = "acb";
+    uint32_t nextMs[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        nextMs[i] = startMs + expanders[i]->getInterval();
+    }
+    for (uint32_t ms = 1; ms <= 1000; ms++) {
+        HostArduino::setMillis(startMs + ms); //Passes 1ms apart, however long the reads took
+        uint32_t earliest = nextMs[0];
+        std::string expected;
+        for (uint8_t i = 0; i < 3; i++) {
+            if ( InputEventsClock::isBefore(nextMs[i], earliest) ) earliest = nextMs[i];
+            if ( InputEventsClock::isBefore(millis(), nextMs[i]) ) continue;
+            expected += names[i];
+            nextMs[i] += expanders[i]->getInterval();
+        }
+        CHECK_EQUAL(bus.nextReadMs(), earliest);
+        readLog.clear();
+        CHECK_EQUAL(bus.update(), expected.size());
+        CHECK(readLog == expected);
+    }
+    CHECK_EQUAL(fast.sampleCount(), 1000);
+    CHECK_EQUAL(medium.sampleCount(), 200);
+    CHECK_EQUAL(slow.sampleCount(), 50);
+    CHECK(bus.sampleRate(fast) > 999 && bus.sampleRate(fast) < 1001);
+    //1250 reads of 100us in 1000ms
+    CHECK(bus.busUtilisation() > 12.4f && bus.busUtilisation() < 12.6f);
+    CHECK_EQUAL(fast.maxReadMicros(), 100);
+}
+
+void checkBudget() {
+    HostArduino::reset();
+    readLog.clear();
+    TestExpanderAdapter a('a', 400), b('b', 400), c('c', 400);
+    ScheduledExpanderAdapter high(a, 1, 10);
+    ScheduledExpanderAdapter mid(b, 1, 5);
+    ScheduledExpanderAdapter low(c, 1);
+    ExpanderBusScheduler bus;
+    bus.add(low);
+    bus.add(mid);
+    bus.add(high);
+    bus.begin();
+    bus.setBudgetMicros(300);
+    readLog.clear();
+    //Only the highest priority expander fits the budget, the others are read when nothing of higher priority is due.
+    //The passes are all in the same ms, however long the reads took.
+    const uint8_t expectedReads[] = { 1, 1, 1, 0 };
+    const char* expectedLogs[] = { "a", "ab", "abc", "abc" };
+    for (uint8_t pass = 0; pass < 4; pass++) {
+        HostArduino::setMillis(1);
+        CHECK_EQUAL(bus.update(), expectedReads[pass]);
+        CHECK(readLog == expectedLogs[pass]);
+    }
+    CHECK_EQUAL(mid.deferrals(), 1);
+    CHECK_EQUAL(low.deferrals(), 2);
+    CHECK_EQUAL(high.deferrals(), 0);
+    //A budget that fits two reads
+    bus.setBudgetMicros(500);
+    readLog.clear();
+    HostArduino::setMillis(2);
+    CHECK_EQUAL(bus.update(), 2);
+    CHECK(readLog == "ab");
+    bus.resetStats();
+    CHECK_EQUAL(low.deferrals(), 0);
+    CHECK_EQUAL(bus.busMicros(), 0);
+}
+
+void checkChangedMask() {
+    HostArduino::reset();
+    TestExpanderAdapter a('a');
+    ScheduledExpanderAdapter scheduled(a, 2);
+    ExpanderBusScheduler bus;
+    bus.add(scheduled);
+    a.pins = 0x01;
+    bus.begin();
+    scheduled.update();
+    CHECK_EQUAL(scheduled.changedMask(), 0); //begin() is the starting state
+    CHECK_EQUAL(scheduled.readAll(), 0x01);
+
+    //Two reads between updates: both changes are picked up, once
+    a.pins = 0x03;
+    HostArduino::advanceMillis(2);
+    bus.update();
+    a.pins = 0x07;
+    HostArduino::advanceMillis(2);
+    bus.update();
+    scheduled.update();
+    CHECK_EQUAL(scheduled.changedMask(), 0x06);
+    CHECK_EQUAL(scheduled.readAll(), 0x07);
+    scheduled.update();
+    CHECK_EQUAL(scheduled.changedMask(), 0);
+
+    //Not read yet, so no change
+    a.pins = 0x0F;
+    HostArduino::advanceMillis(1);
+    bus.update();
+    scheduled.update();
+    CHECK_EQUAL(scheduled.changedMask(), 0);
+    CHECK_EQUAL(scheduled.sampleAgeMs(), 1);
+    HostArduino::advanceMillis(1);
+    bus.update();
+    scheduled.update();
+    CHECK_EQUAL(scheduled.changedMask(), 0x08);
+}
+
+}
+
+int main() {
+    checkOrder();
+    checkIntervals(0);
+    checkIntervals(0xFFFFFE00);
+    checkBudget();
+    checkChangedMask();
+    return checkResult();
+}
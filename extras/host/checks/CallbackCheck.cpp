@@ -0,0 +1,66 @@
+/**
+ * Compile check: every input class accepts a function, a class method and a capturing lambda as its callback.
+ *
+ * Templates such as setCallback(T* instance, method) are only compiled when they are used, and no example uses all
+ * of them, so this file uses each one. It is built (not run) with the host build.
+ */
+
+#include <Arduino.h>
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventEncoder.h>
+#include <EventEncoderButton.h>
+#include <EventAnalog.h>
+#include <EventJoystick.h>
+#include <EventKeyMatrix.h>
+
+namespace {
+
+uint32_t events = 0;
+
+void onButton(InputEventType et, EventButton& ie) { events++; }
+void onSwitch(InputEventType et, EventSwitch& ie) { events++; }
+void onEncoder(InputEventType et, EventEncoder& ie) { events++; }
+void onEncoderButton(InputEventType et, EventEncoderButton& ie) { events++; }
+void onAnalog(InputEventType et, EventAnalog& ie) { events++; }
+void onJoystick(InputEventType et, EventJoystick& ie) { events++; }
+void onKeyMatrix(InputEventType et, EventKeyMatrix& ie) { events++; }
+
+struct Handler {
+    uint32_t count = 0;
+    void onButton(InputEventType et, EventButton& ie) { count++; }
+    void onSwitch(InputEventType et, EventSwitch& ie) { count++; }
+    void onEncoder(InputEventType et, EventEncoder& ie) { count++; }
+    void onEncoderButton(InputEventType et, EventEncoderButton& ie) { count++; }
+    void onAnalog(InputEventType et, EventAnalog& ie) { count++; }
+    void onJoystick(InputEventType et, EventJoystick& ie) { count++; }
+    void onKeyMatrix(InputEventType et, EventKeyMatrix& ie) { count++; }
+};
+
+template <typename Input, typename Method>
+void setAllCallbacks(Input& input, void (*function)(InputEventType, Input&), Handler& handler, Method method) {
+    input.setCallback(function);
+    input.setCallback(&handler, method);
+    input.setCallback([&handler](InputEventType et, Input& ie) { handler.count++; });
+    input.unsetCallback();
+}
+
+}
+
+void inputEventsCallbackCheck(IEncoderAdapter* encoderAdapter, const byte* rowPins, const byte* columnPins) {
+    Handler handler;
+    EventButton button(2);
+    EventSwitch eventSwitch(3);
+    EventEncoder encoder(encoderAdapter);
+    EventEncoderButton encoderButton(encoderAdapter, 4);
+    EventAnalog analog(A0);
+    EventJoystick joystick(A0, A1);
+    EventKeyMatrix keyMatrix(rowPins, 2, columnPins, 2);
+    setAllCallbacks(button, onButton, handler, &Handler::onButton);
+    setAllCallbacks(eventSwitch, onSwitch, handler, &Handler::onSwitch);
+    setAllCallbacks(encoder, onEncoder, handler, &Handler::onEncoder);
+    setAllCallbacks(encoderButton, onEncoderButton, handler, &Handler::onEncoderButton);
+    setAllCallbacks(analog, onAnalog, handler, &Handler::onAnalog);
+    setAllCallbacks(joystick, onJoystick, handler, &Handler::onJoystick);
+    setAllCallbacks(keyMatrix, onKeyMatrix, handler, &Handler::onKeyMatrix);
+}
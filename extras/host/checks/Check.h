@@ -0,0 +1,51 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_CHECK_H
+#define INPUT_EVENTS_HOST_CHECK_H
+
+#include <stdio.h>
+
+/**
+ * Minimal assertions for the host check programs (checks/<name>.cpp, see add_host_check() in CMakeLists.txt).
+ *
+ * A failed CHECK() prints the file, line and expression and the check continues, so one run reports every failure.
+ * main() returns checkResult(), which is non zero if any CHECK() failed.
+ */
+
+/// \cond DO_NOT_DOCUMENT
+namespace HostCheck {
+    inline unsigned& failures() { static unsigned count = 0; return count; }
+    inline bool report(bool ok, const char* file, int line, const char* expr) {
+        if ( ok ) return true;
+        printf("%s:%d: CHECK(%s) failed\n", file, line, expr);
+        failures()++;
+        return false;
+    }
+    inline bool reportEqual(long long actual, long long expected, const char* file, int line, const char* expr) {
+        if ( actual == expected ) return true;
+        printf("%s:%d: CHECK_EQUAL(%s) failed: %lld != %lld\n", file, line, expr, actual, expected);
+        failures()++;
+        return false;
+    }
+}
+/// \endcond
+
+#define CHECK(cond) HostCheck::report((cond), __FILE__, __LINE__, #cond)
+#define CHECK_EQUAL(actual, expected) \
+    HostCheck::reportEqual((long long)(actual), (long long)(expected), __FILE__, __LINE__, #actual ", " #expected)
+
+inline int checkResult() {
+    if ( HostCheck::failures() ) {
+        printf("%u check(s) failed\n", HostCheck::failures());
+        return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * Check: the expander debouncers.
+ *
+ * - VerticalCounterDebouncer (8, 16 and 32 bit) changes each pin exactly as a per-pin counter does: after four
+ *   consecutive samples in the new state, with any sample in the old state starting the count again.
+ * - DebouncedExpanderAdapter accepts a change 9-12ms after it happens (with the default 3ms interval), ignores
+ *   bounces shorter than that, only reports a change on the update that accepts it and masks pins above pinCount.
+ */
+
+#include <Arduino.h>
+#include <GpioExpanderAdapter/VerticalCounterDebouncer.h>
+#include <GpioExpanderAdapter/DebouncedExpanderAdapter.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+/**
+ * The reference: one counter per pin.
+ */
+struct PinDebouncer {
+    bool state;
+    uint8_t count;
+    bool update(bool sample) {
+        if ( sample == state ) {
+            count = 0;
+            return false;
+        }
+        if ( ++count < 4 ) return false;
+        state = sample;
+        count = 0;
+        return true;
+    }
+};
+
+template <typename T>
+void checkVerticalCounter() {
+    const uint8_t PINS = sizeof(T) * 8;
+    VerticalCounterDebouncer<T> debouncer;
+    PinDebouncer pins[PINS];
+    T initial = (T)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+    debouncer.begin(initial);
+    for (uint8_t pin = 0; pin < PINS; pin++) {
+        pins[pin] = { (bool)((initial >> pin) & 1), 0 };
+    }
+    T sample = initial;
+    for (uint16_t i = 0; i < 20000; i++) {
+        //Mostly steady pins, some bouncing
+        for (uint8_t flips = rand() % 3; flips; flips--) {
+            sample ^= (T)((T)1 << (rand() % PINS));
+        }
+        T state = debouncer.update(sample);
+        T changed = 0;
+        T expected = 0;
+        bool settling = false;
+        for (uint8_t pin = 0; pin < PINS; pin++) {
+            if ( pins[pin].update((sample >> pin) & 1) ) changed |= (T)((T)1 << pin);
+            if ( pins[pin].state ) expected |= (T)((T)1 << pin);
+            settling |= pins[pin].count != 0;
+        }
+        CHECK_EQUAL(state, expected);
+        CHECK_EQUAL(debouncer.read(), expected);
+        CHECK_EQUAL(debouncer.changed(), changed);
+        CHECK_EQUAL(debouncer.isSettling(), settling);
+    }
+}
+
+/**
+ * An expander whose pins are set by the check.
+ */
+class TestExpanderAdapter : public GpioExpanderAdapter {
+public:
+    void begin() override {}
+    void update() override { updates++; }
+    bool read(byte pin) override { return bitRead(pins, pin); }
+    uint32_t readAll() override { return pins; }
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+    uint32_t pins = 0xFFFFFFFF;
+    uint32_t updates = 0;
+};
+
+/**
+ * Update every ms until the debounced state of pin 0 is level. Returns the ms taken (or 0xFFFF if it is not).
+ */
+uint16_t msUntil(DebouncedExpanderAdapter& expander, bool level, uint16_t maxMs = 50) {
+    for (uint16_t ms = 1; ms <= maxMs; ms++) {
+        HostArduino::advanceMillis(1);
+        expander.update();
+        if ( expander.read(0) == level ) {
+            CHECK_EQUAL(expander.changedMask(), bit(0));
+            expander.update(); //Reported once
+            CHECK_EQUAL(expander.changedMask(), 0);
+            return ms;
+        }
+        CHECK_EQUAL(expander.changedMask(), 0);
+    }
+    return 0xFFFF;
+}
+
+void checkDebouncedExpander() {
+    HostArduino::reset();
+    TestExpanderAdapter pins;
+    DebouncedExpanderAdapter expander(pins, 3, 16);
+    expander.begin();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF); //Pins above 16 are masked
+    CHECK(!expander.isSettling());
+
+    //A press at any point in the sample interval is accepted 9-12ms later
+    for (uint8_t offset = 0; offset < 3; offset++) {
+        HostArduino::advanceMillis(offset + 20);
+        expander.update();
+        pins.pins &= ~(uint32_t)1;
+        uint16_t ms = msUntil(expander, LOW);
+        CHECK(ms >= 9 && ms <= 12);
+        pins.pins |= 1;
+        ms = msUntil(expander, HIGH);
+        CHECK(ms >= 9 && ms <= 12);
+    }
+
+    //Bounces of less than four samples are ignored, and the count starts again after each
+    uint32_t updates = pins.updates;
+    for (uint8_t bounce = 0; bounce < 10; bounce++) {
+        pins.pins &= ~(uint32_t)1;
+        for (uint8_t ms = 0; ms < 9; ms++) {
+            HostArduino::advanceMillis(1);
+            expander.update();
+            CHECK_EQUAL(expander.changedMask(), 0);
+        }
+        CHECK(expander.isSettling());
+        pins.pins |= 1;
+        HostArduino::advanceMillis(3);
+        expander.update();
+        CHECK_EQUAL(expander.changedMask(), 0);
+    }
+    CHECK_EQUAL(expander.read(0), HIGH);
+    CHECK_EQUAL(pins.updates - updates, 40); //Sampled every 3ms only
+
+    //A pin above pinCount never changes
+    pins.pins &= ~((uint32_t)1 << 20);
+    for (uint8_t ms = 0; ms < 50; ms++) {
+        HostArduino::advanceMillis(1);
+        expander.update();
+        CHECK_EQUAL(expander.changedMask(), 0);
+    }
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+}
+
+}
+
+int main() {
+    srand(11);
+    checkVerticalCounter<uint8_t>();
+    checkVerticalCounter<uint16_t>();
+    checkVerticalCounter<uint32_t>();
+    checkDebouncedExpander();
+    return checkResult();
+}
@@ -0,0 +1,168 @@
+/**
+ * Check: the quadrature decoders.
+ *
+ * - QuadratureWordDecoder steps every encoder in the word exactly as BaseTableEncoderAdapter does, for all 16
+ *   transitions of each encoder and for random changes to many encoders at once.
+ * - BaseTableEncoderAdapter counts an illegal transition for each read that misses a step, and measures the edge rate
+ *   (and so the suggested poll rate) whether or not steps are being missed.
+ */
+
+#include <Arduino.h>
+#include <EncoderAdapter/BaseTableEncoderAdapter.h>
+#include <EncoderAdapter/QuadratureWordDecoder.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+/**
+ * A BaseTableEncoderAdapter whose A and B pins are set by the check.
+ */
+class TestTableEncoderAdapter : public BaseTableEncoderAdapter {
+public:
+    TestTableEncoderAdapter() {
+        _pinA = 0;
+        _pinB = 1;
+    }
+    bool begin() override { return true; }
+    void setPins(uint8_t a, uint8_t b) {
+        pins[0] = a;
+        pins[1] = b;
+    }
+    void start(uint8_t a, uint8_t b) {
+        setPins(a, b);
+        _prevState = (a << 1) | b;
+    }
+protected:
+    uint8_t readPin(uint8_t pin) const override { return pins[pin]; }
+private:
+    uint8_t pins[2] = {};
+};
+
+uint8_t laneA(uint32_t word, uint8_t encoder) { return (word >> (2 * encoder)) & 1; }
+uint8_t laneB(uint32_t word, uint8_t encoder) { return (word >> (2 * encoder + 1)) & 1; }
+
+void checkAllTransitions() {
+    for (uint8_t encoder = 0; encoder < QuadratureWordDecoder::MAX_ENCODERS; encoder++) {
+        for (uint8_t from = 0; from < 4; from++) {
+            for (uint8_t to = 0; to < 4; to++) {
+                //Every other encoder sits on a random (unchanging) state
+                uint32_t others = (((uint32_t)rand() << 16) ^ (uint32_t)rand()) & ~((uint32_t)3 << (2 * encoder));
+                uint32_t before = others | ((uint32_t)(((from & 1) << 1) | (from >> 1)) << (2 * encoder));
+                uint32_t after = others | ((uint32_t)(((to & 1) << 1) | (to >> 1)) << (2 * encoder));
+                FixedQuadratureWordDecoder<QuadratureWordDecoder::MAX_ENCODERS> decoder;
+                decoder.begin(before);
+                uint16_t moved = decoder.update(after);
+
+                TestTableEncoderAdapter table;
+                table.start(from >> 1, from & 1);
+                table.setPins(to >> 1, to & 1);
+                int32_t expected = table.getPosition();
+
+                CHECK_EQUAL(decoder.delta(encoder), expected);
+                CHECK_EQUAL(decoder.getPosition(encoder), expected);
+                CHECK_EQUAL(moved, expected ? bit(encoder) : 0);
+                CHECK_EQUAL(decoder.errorMask(), (from ^ to) == 3 ? bit(encoder) : 0);
+                CHECK_EQUAL(decoder.errorCount(), table.illegalTransitions());
+            }
+        }
+    }
+}
+
+void checkRandomWords() {
+    const uint8_t counts[] = { 1, 5, 8, 16 };
+    for (uint8_t count : counts) {
+        int32_t positions[QuadratureWordDecoder::MAX_ENCODERS];
+        QuadratureWordDecoder decoder(positions, count);
+        TestTableEncoderAdapter tables[QuadratureWordDecoder::MAX_ENCODERS];
+        uint32_t word = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        decoder.begin(word);
+        for (uint8_t e = 0; e < count; e++) {
+            decoder.setPosition(e, 0);
+            tables[e].start(laneA(word, e), laneB(word, e));
+        }
+        for (uint32_t i = 0; i < 20000; i++) {
+            for (uint8_t flips = rand() % 4; flips; flips--) {
+                word ^= (uint32_t)1 << (rand() % 32);
+            }
+            decoder.update(word);
+            for (uint8_t e = 0; e < count; e++) {
+                tables[e].setPins(laneA(word, e), laneB(word, e));
+                tables[e].update();
+            }
+        }
+        uint32_t illegal = 0;
+        for (uint8_t e = 0; e < count; e++) {
+            CHECK_EQUAL(decoder.getPosition(e), tables[e].getPosition());
+            illegal += tables[e].illegalTransitions();
+        }
+        CHECK_EQUAL(decoder.errorCount(), illegal);
+    }
+}
+
+/**
+ * An encoder turning forward at 2000 edges a second, read every pollUs.
+ */
+void checkPollRate(uint32_t pollUs) {
+    static const uint8_t gray[4] = { 0, 1, 3, 2 }; //A << 1 | B
+    HostArduino::reset();
+    TestTableEncoderAdapter encoder;
+    encoder.start(0, 0);
+    uint32_t edges = 0;
+    uint32_t nextEdgeUs = 500;
+    for (uint32_t us = 0; us < 1000000; us += pollUs) {
+        while ( nextEdgeUs <= us ) {
+            edges++;
+            nextEdgeUs += 500;
+        }
+        encoder.setPins(gray[edges & 3] >> 1, gray[edges & 3] & 1);
+        encoder.update();
+        HostArduino::advanceMicros(pollUs);
+    }
+    int32_t position = encoder.getPosition();
+    CHECK(position >= 0);
+    //No step is missed while each edge is read at least once
+    if ( pollUs < 500 ) {
+        CHECK_EQUAL(encoder.illegalTransitions(), 0);
+    } else {
+        CHECK(encoder.illegalTransitions() > 0);
+    }
+    //Each illegal transition is two edges that could not be counted (the last edge may not have been read)
+    CHECK((uint32_t)position + 2 * encoder.illegalTransitions() <= edges);
+    CHECK((uint32_t)position + 2 * encoder.illegalTransitions() + 1 >= edges);
+    if ( pollUs == 1000 ) CHECK_EQUAL(position, 0); //Every read misses a step
+
+    //Missed steps are still counted as edges, so the rate (and the suggested poll rate) is right either way
+    CHECK(encoder.edgeRate() >= 1950 && encoder.edgeRate() <= 2050);
+    CHECK(encoder.peakEdgeRate() >= encoder.edgeRate());
+    CHECK(encoder.peakEdgeRate() <= 2100);
+    CHECK_EQUAL(encoder.suggestedPollRate(), 2 * (uint32_t)encoder.peakEdgeRate());
+
+    //A pause is ended by the next edge and lowers the rate, rather than raising it
+    uint16_t peak = encoder.peakEdgeRate();
+    HostArduino::advanceMillis(1000);
+    edges++;
+    encoder.setPins(gray[edges & 3] >> 1, gray[edges & 3] & 1);
+    encoder.update();
+    CHECK(encoder.edgeRate() < 200);
+    CHECK_EQUAL(encoder.peakEdgeRate(), peak);
+
+    encoder.resetStats();
+    CHECK_EQUAL(encoder.illegalTransitions(), 0);
+    CHECK_EQUAL(encoder.edgeRate(), 0);
+    CHECK_EQUAL(encoder.peakEdgeRate(), 0);
+}
+
+}
+
+int main() {
+    srand(22);
+    checkAllTransitions();
+    checkRandomWords();
+    checkPollRate(100);
+    checkPollRate(250);
+    checkPollRate(400);
+    checkPollRate(700);
+    checkPollRate(1000);
+    return checkResult();
+}
@@ -0,0 +1,111 @@
+/**
+ * Check: EventEncoder's position divider.
+ *
+ * - position() moves by the raw position divided by the positionDivider, rounded down, for positive and negative raw
+ *   positions (across zero and at the ends of the range) and for power of two and other dividers.
+ * - Changing the divider does not fire CHANGED.
+ */
+
+#include <Arduino.h>
+#include <EventEncoder.h>
+#include <EncoderAdapter/IEncoderAdapter.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+/**
+ * An encoder adapter whose (raw) position is set by the check.
+ */
+class TestEncoderAdapter : public IEncoderAdapter {
+public:
+    bool begin() override { return true; }
+    int32_t getPosition() override { return position; }
+    void setPosition(int32_t pos) override { position = pos; }
+private:
+    int32_t position = 0;
+};
+
+uint32_t changedCount = 0;
+
+void onEncoder(InputEventType et, EventEncoder& ie) {
+    if ( et == InputEventType::CHANGED ) changedCount++;
+}
+
+/**
+ * The reference: floor division, in 64 bits so the ends of the int32_t range are safe.
+ */
+int64_t floorDivide(int64_t raw, int64_t divider) {
+    int64_t divided = raw / divider;
+    if ( raw % divider != 0 && raw < 0 ) divided--;
+    return divided;
+}
+
+/**
+ * A random walk of the raw position from centre, staying within range of it.
+ */
+void walk(EventEncoder& encoder, TestEncoderAdapter& adapter, uint8_t divider, int32_t centre, int32_t range) {
+    //Re-enabling carries on from the adapter's position without firing CHANGED
+    adapter.setPosition(centre);
+    encoder.enable(false);
+    encoder.enable(true);
+    long start = encoder.position();
+    int64_t base = floorDivide(centre, divider);
+    int64_t raw = centre;
+    for (uint16_t i = 0; i < 20000; i++) {
+        raw += (rand() % 7) - 3;
+        if ( raw > (int64_t)centre + range ) raw = (int64_t)centre + range;
+        if ( raw < (int64_t)centre - range ) raw = (int64_t)centre - range;
+        adapter.setPosition((int32_t)raw);
+        encoder.update();
+        CHECK_EQUAL(encoder.position() - start, floorDivide(raw, divider) - base);
+    }
+}
+
+void checkDividers() {
+    const uint8_t dividers[] = { 1, 2, 3, 4, 5, 7, 8, 16, 255 };
+    HostArduino::reset();
+    TestEncoderAdapter adapter;
+    EventEncoder encoder(&adapter);
+    encoder.begin();
+    encoder.setCallback(onEncoder);
+    for (uint8_t divider : dividers) {
+        encoder.setPositionDivider(divider);
+        walk(encoder, adapter, divider, 0, 600); //Back and forth across zero
+        walk(encoder, adapter, divider, -2147483647 - 1 + 300, 300);
+        walk(encoder, adapter, divider, 2147483647 - 300, 300);
+    }
+}
+
+void checkChangingDivider() {
+    HostArduino::reset();
+    TestEncoderAdapter adapter;
+    EventEncoder encoder(&adapter);
+    encoder.begin();
+    encoder.setCallback(onEncoder);
+    adapter.setPosition(-7);
+    encoder.update();
+    long position = encoder.position();
+    CHECK_EQUAL(position, -2);
+    changedCount = 0;
+    encoder.setPositionDivider(3);
+    encoder.update();
+    encoder.setPositionDivider(1);
+    encoder.update();
+    CHECK_EQUAL(changedCount, 0);
+    CHECK_EQUAL(encoder.position(), position);
+    //And the next turn is divided by the new divider
+    adapter.setPosition(-9);
+    encoder.update();
+    CHECK_EQUAL(changedCount, 1);
+    CHECK_EQUAL(encoder.position(), position - 2);
+}
+
+}
+
+int main() {
+    srand(25);
+    checkDividers();
+    checkChangingDivider();
+    return checkResult();
+}
@@ -0,0 +1,140 @@
+/**
+ * Check: EventQueue.
+ *
+ * - Events are popped in the order they were pushed, across wraps of the free running indices.
+ * - DROP_NEWEST keeps the oldest events and DROP_OLDEST the newest, and both count every dropped event.
+ * - pop() leaves the interrupt state as it found it, with either policy.
+ * - Queued events are dispatched to their callback later, with the timestamp and payload from when they fired.
+ */
+
+#include <Arduino.h>
+#include <EventQueue.h>
+#include <EventEncoder.h>
+#include <EncoderAdapter/IEncoderAdapter.h>
+#include "Check.h"
+
+namespace {
+
+QueuedEvent event(int32_t payload) {
+    QueuedEvent e = { nullptr, InputEventType::CHANGED, 0, payload };
+    return e;
+}
+
+void checkOrder() {
+    FixedEventQueue<8> queue;
+    QueuedEvent popped;
+    int32_t pushed = 0;
+    int32_t expected = 0;
+    //Well past 256 pushes so the uint8_t indices wrap, with the queue at every fill level
+    for (uint16_t i = 0; i < 1000; i++) {
+        for (uint8_t n = i % 9; n && queue.size() < queue.capacity(); n--) {
+            CHECK(queue.push(event(pushed++)));
+        }
+        for (uint8_t n = (i * 7) % 9; n; n--) {
+            if ( !queue.pop(popped) ) break;
+            CHECK_EQUAL(popped.payload, expected++);
+        }
+        CHECK_EQUAL(queue.size(), pushed - expected);
+        CHECK_EQUAL(queue.isEmpty(), pushed == expected);
+    }
+    CHECK(pushed > 256);
+    CHECK_EQUAL(queue.overflowCount(), 0);
+}
+
+void checkOverflow(EventQueue::OverflowPolicy policy) {
+    FixedEventQueue<4> queue;
+    queue.setOverflowPolicy(policy);
+    for (int32_t i = 0; i < 10; i++) {
+        bool kept = queue.push(event(i));
+        CHECK_EQUAL(kept, i < 4 || policy == EventQueue::OverflowPolicy::DROP_OLDEST);
+    }
+    CHECK_EQUAL(queue.size(), 4);
+    CHECK_EQUAL(queue.overflowCount(), 6);
+    QueuedEvent popped;
+    int32_t first = policy == EventQueue::OverflowPolicy::DROP_OLDEST ? 6 : 0;
+    for (int32_t i = first; i < first + 4; i++) {
+        CHECK(queue.pop(popped));
+        CHECK_EQUAL(popped.payload, i);
+    }
+    CHECK(!queue.pop(popped));
+    queue.resetOverflowCount();
+    CHECK_EQUAL(queue.overflowCount(), 0);
+}
+
+void checkInterruptState(EventQueue::OverflowPolicy policy) {
+    HostArduino::reset();
+    FixedEventQueue<4> queue;
+    queue.setOverflowPolicy(policy);
+    QueuedEvent popped;
+    queue.push(event(1));
+    queue.push(event(2));
+    CHECK(queue.pop(popped));
+    CHECK(interruptsAreEnabled());
+    //Popped with interrupts disabled (eg from a timer ISR), they must not be enabled by the pop
+    noInterrupts();
+    CHECK(queue.pop(popped));
+    CHECK(!interruptsAreEnabled());
+    CHECK(!queue.pop(popped));
+    CHECK(!interruptsAreEnabled());
+    interrupts();
+}
+
+/**
+ * An encoder adapter whose position is set by the check.
+ */
+class TestEncoderAdapter : public IEncoderAdapter {
+public:
+    bool begin() override { return true; }
+    int32_t getPosition() override { return position; }
+    void setPosition(int32_t pos) override { position = pos; }
+private:
+    int32_t position = 0;
+};
+
+FixedEventQueue<8> dispatchQueue;
+uint8_t callbacks = 0;
+
+void onEncoder(InputEventType et, EventEncoder& ie) {
+    CHECK(et == InputEventType::CHANGED);
+    CHECK(dispatchQueue.current().input == &ie);
+    //The increment and time of each turn, not the encoder's state now
+    CHECK_EQUAL(dispatchQueue.current().payload, callbacks + 1);
+    CHECK_EQUAL(dispatchQueue.current().timestampMs, 100 * (callbacks + 1));
+    callbacks++;
+}
+
+void checkDispatch() {
+    HostArduino::reset();
+    TestEncoderAdapter adapter;
+    EventEncoder encoder(&adapter);
+    encoder.begin();
+    encoder.setPositionDivider(1);
+    encoder.setCallback(onEncoder);
+    encoder.setEventQueue(&dispatchQueue);
+    int32_t position = 0;
+    for (int32_t turn = 1; turn <= 3; turn++) {
+        HostArduino::setMillis(100 * turn);
+        position += turn;
+        adapter.setPosition(position);
+        encoder.update();
+    }
+    CHECK_EQUAL(callbacks, 0);
+    CHECK_EQUAL(dispatchQueue.size(), 3);
+    CHECK_EQUAL(dispatchQueue.dispatch(2), 2);
+    CHECK_EQUAL(callbacks, 2);
+    CHECK_EQUAL(dispatchQueue.dispatch(), 1);
+    CHECK_EQUAL(callbacks, 3);
+    CHECK(dispatchQueue.current().input == nullptr);
+}
+
+}
+
+int main() {
+    checkOrder();
+    checkOverflow(EventQueue::OverflowPolicy::DROP_NEWEST);
+    checkOverflow(EventQueue::OverflowPolicy::DROP_OLDEST);
+    checkInterruptState(EventQueue::OverflowPolicy::DROP_NEWEST);
+    checkInterruptState(EventQueue::OverflowPolicy::DROP_OLDEST);
+    checkDispatch();
+    return checkResult();
+}
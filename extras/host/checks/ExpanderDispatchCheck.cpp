@@ -0,0 +1,171 @@
+/**
+ * Check: ExpanderInputDispatcher.
+ *
+ * - With scheduling, a dispatcher fires exactly the same events (at the same times) as the same inputs added to an
+ *   unscheduled manager, from the default start time and across a millis() rollover. Within a pass, changed inputs
+ *   are updated before due ones so only the order of events with the same timestamp may differ.
+ * - An unsubscribed (or replaced) input is not updated again, even if it had a deadline pending.
+ */
+
+#include <Arduino.h>
+#include <EventButton.h>
+#include <EventEncoderButton.h>
+#include <InputManager.h>
+#include <ExpanderInputDispatcher.h>
+#include <GpioExpanderAdapter/AdafruitMCP23017ExpanderAdapter.h>
+#include <PinAdapter/ExpanderPinAdapter.h>
+#include <EncoderAdapter/ExpanderEncoderAdapter.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Check.h"
+
+namespace {
+
+std::vector<std::string> eventLog;
+uint16_t eventCounts[16] = {};
+
+void onButton(InputEventType et, EventButton& ie) {
+    char line[48];
+    snprintf(line, sizeof(line), "%lu b%u %u %u\n", (unsigned long)millis(), ie.getInputId(), (unsigned)et, ie.clickCount());
+    eventLog.push_back(line);
+    eventCounts[ie.getInputId()]++;
+}
+
+void onEncoderButton(InputEventType et, EventEncoderButton& ie) {
+    char line[48];
+    snprintf(line, sizeof(line), "%lu e %u %ld\n", (unsigned long)millis(), (unsigned)et, (long)ie.position());
+    eventLog.push_back(line);
+}
+
+/**
+ * 12 buttons and an encoder button on one MCP23017 driven by a random (but repeatable) walk for 30 seconds.
+ */
+std::vector<std::string> randomPanel(bool scheduled, uint32_t startMs) {
+    HostArduino::reset();
+    HostArduino::setMillis(startMs);
+    eventLog.clear();
+    AdafruitMCP23017ExpanderAdapter expander;
+    expander.begin(0x20);
+    ExpanderInputDispatcher panel(expander);
+    InputManager inputs;
+    EventButton* buttons[12]; //Not deleted - the check exits shortly
+    for (uint8_t i = 0; i < 12; i++) {
+        buttons[i] = new EventButton(new ExpanderPinAdapter(i, expander));
+        buttons[i]->begin();
+        buttons[i]->setInputId(i);
+        buttons[i]->setCallback(onButton);
+        if ( scheduled ) panel.subscribe(*buttons[i], bit(i)); else inputs.add(*buttons[i]);
+    }
+    EventEncoderButton encoderButton(new ExpanderEncoderAdapter(12, 13, expander), new ExpanderPinAdapter(14, expander));
+    encoderButton.begin();
+    encoderButton.setCallback(onEncoderButton);
+    if ( scheduled ) {
+        panel.subscribe(encoderButton, bit(12) | bit(13) | bit(14));
+        inputs.add(panel);
+        inputs.enableScheduling();
+    } else {
+        inputs.add(encoderButton);
+    }
+
+    static const uint8_t gray[4] = { 0, 1, 3, 2 };
+    uint8_t phase = 0;
+    uint16_t pins = 0xFFFF;
+    srand(42);
+    for (uint32_t ms = 0; ms < 30000; ms++) {
+        if ( rand() % 50 == 0 ) pins ^= 1 << (rand() % 12);
+        if ( rand() % 40 == 0 ) {
+            phase = (phase + (rand() % 2 ? 1 : 3)) & 3;
+            pins = (pins & ~(3 << 12)) | (gray[phase] << 12);
+        }
+        if ( rand() % 300 == 0 ) pins ^= 1 << 14;
+        HostArduino::setI2CInputs(0x20, pins);
+        if ( !scheduled ) expander.update();
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    std::sort(eventLog.begin(), eventLog.end());
+    return eventLog;
+}
+
+void checkScheduledMatchesUnscheduled() {
+    const uint32_t starts[] = { 0, 0xFFFFF000 };
+    for (uint32_t start : starts) {
+        std::vector<std::string> unscheduled = randomPanel(false, start);
+        std::vector<std::string> scheduled = randomPanel(true, start);
+        CHECK(unscheduled.size() > 500);
+        CHECK(scheduled == unscheduled);
+    }
+}
+
+/**
+ * Press buttons 0 and 1 so each has a LONG_PRESS (and IDLE) deadline pending, then unsubscribe button 0 and replace
+ * button 1 by subscribing button 2 to its pin. Neither may fire again, even when their pins change.
+ */
+void checkUnsubscribe() {
+    HostArduino::reset();
+    memset(eventCounts, 0, sizeof(eventCounts));
+    AdafruitMCP23017ExpanderAdapter expander;
+    expander.begin(0x20);
+    ExpanderInputDispatcher panel(expander);
+    InputManager inputs;
+    EventButton button0(new ExpanderPinAdapter(0, expander));
+    EventButton button1(new ExpanderPinAdapter(1, expander));
+    EventButton button2(new ExpanderPinAdapter(1, expander));
+    EventButton* buttons[] = { &button0, &button1, &button2 };
+    for (uint8_t i = 0; i < 3; i++) {
+        buttons[i]->begin();
+        buttons[i]->setInputId(i);
+        buttons[i]->setIdleTimeout(2000);
+        buttons[i]->setCallback(onButton);
+    }
+    panel.subscribe(button0, bit(0));
+    panel.subscribe(button1, bit(1));
+    inputs.add(panel);
+    inputs.enableScheduling();
+
+    HostArduino::setI2CInputs(0x20, 0xFFFC); //Press 0 and 1
+    for (uint16_t ms = 0; ms < 100; ms++) {
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    CHECK_EQUAL(eventCounts[0], 1); //PRESSED
+    CHECK_EQUAL(eventCounts[1], 1);
+
+    CHECK(panel.unsubscribe(button0));
+    CHECK(!panel.unsubscribe(button0));
+    panel.subscribe(button2, bit(1));
+    CHECK_EQUAL(panel.count(), 1);
+    CHECK(panel.subscriber(1) == &button2);
+
+    for (uint16_t ms = 0; ms < 5000; ms++) {
+        if ( ms == 1000 ) HostArduino::setI2CInputs(0x20, 0xFFFF); //Release both
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    CHECK_EQUAL(eventCounts[0], 1);
+    CHECK_EQUAL(eventCounts[1], 1);
+    CHECK(eventCounts[2] > 0); //The replacement is updated (first pass, release, IDLE)
+
+    //An input unsubscribed before its dispatcher is removed must not be left in the manager's timer wheel either
+    HostArduino::setI2CInputs(0x20, 0xFFFD); //Press 2 so its LONG_PRESS is pending
+    for (uint16_t ms = 0; ms < 100; ms++) {
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    uint32_t deadlineMs;
+    CHECK(inputs.nextDeadline(deadlineMs));
+    CHECK(panel.unsubscribe(button2));
+    CHECK(!inputs.nextDeadline(deadlineMs));
+    CHECK(inputs.remove(panel));
+    CHECK(!inputs.nextDeadline(deadlineMs));
+}
+
+}
+
+int main() {
+    checkScheduledMatchesUnscheduled();
+    checkUnsubscribe();
+    return checkResult();
+}
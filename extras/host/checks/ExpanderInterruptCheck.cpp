@@ -0,0 +1,138 @@
+/**
+ * Check: the interrupt (INT line) modes of the I2C expander adapters.
+ *
+ * - MCP23017: the bus is only read when INT is asserted. Only the capture register of the port that interrupted is
+ *   used - the other port's INTCAP may still hold an old capture.
+ * - PCF8574/PCF8575: the bus is only read when INT is asserted or the refresh interval has passed, and changedMask()
+ *   is zero on the updates that do not read it.
+ */
+
+#include <Arduino.h>
+#include <GpioExpanderAdapter/AdafruitMCP23017ExpanderAdapter.h>
+#include <GpioExpanderAdapter/AdafruitPCF8574ExpanderAdapter.h>
+#include <GpioExpanderAdapter/AdafruitPCF8575ExpanderAdapter.h>
+#include <GpioExpanderAdapter/RobTillaartPCF8575ExpanderAdapter.h>
+#include "Check.h"
+
+namespace {
+
+const uint8_t ADDRESS = 0x20;
+const uint8_t INT_PIN = 2;
+
+void checkMcp23017() {
+    HostArduino::reset();
+    HostArduino::setI2CInterruptPin(ADDRESS, INT_PIN);
+    AdafruitMCP23017ExpanderAdapter expander;
+    expander.begin(ADDRESS);
+    expander.attachPin(1); //Port A
+    expander.attachPin(9); //Port B
+    CHECK(expander.enableInterrupt(INT_PIN));
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+
+    //Nothing changed, so nothing is read
+    uint32_t reads = HostArduino::i2cReadCount();
+    for (uint8_t i = 0; i < 10; i++) {
+        expander.update();
+    }
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads);
+    CHECK_EQUAL(expander.changedMask(), 0);
+
+    //A press on port B is seen from INTCAPB, then the pins are read
+    HostArduino::setI2CInputs(ADDRESS, 0xFDFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFDFF);
+    CHECK_EQUAL(expander.changedMask(), bit(9));
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFDFF);
+    CHECK_EQUAL(expander.changedMask(), 0);
+
+    //A port B click between updates: INTCAPB holds the press and is not captured again by the release
+    HostArduino::setI2CInputs(ADDRESS, 0xFFFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+    HostArduino::setI2CInputs(ADDRESS, 0xFDFF);
+    HostArduino::setI2CInputs(ADDRESS, 0xFFFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFDFF); //The press is not lost
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+
+    //A press on port A. INTCAPB still holds pin 9 pressed, which must not be used
+    HostArduino::setI2CInputs(ADDRESS, 0xFFFD);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFD);
+    CHECK_EQUAL(expander.changedMask(), bit(1));
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFD);
+    CHECK_EQUAL(expander.changedMask(), 0);
+
+    //Both ports between updates: port A's capture is used and port B is read on the next update
+    HostArduino::setI2CInputs(ADDRESS, 0xFDFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFDFF);
+
+    //Back to polling
+    expander.disableInterrupt();
+    HostArduino::setI2CInputs(ADDRESS, 0xFFFF);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), 0xFFFF);
+}
+
+/**
+ * The PCF857x adapters share their interrupt handling, so each is checked the same way.
+ */
+template <typename Adapter>
+void checkPcf857x(uint32_t pressed, uint32_t released) {
+    HostArduino::reset();
+    HostArduino::setI2CInterruptPin(ADDRESS, INT_PIN);
+    Adapter expander;
+    expander.begin(); //At the default address (0x20)
+    CHECK(expander.enableInterrupt(INT_PIN, 500));
+    uint32_t reads = HostArduino::i2cReadCount();
+
+    //Nothing changed, so nothing is read until the refresh
+    for (uint16_t ms = 0; ms < 499; ms++) {
+        expander.update();
+        CHECK_EQUAL(expander.changedMask(), 0);
+        HostArduino::advanceMillis(1);
+    }
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads);
+    HostArduino::advanceMillis(1);
+    expander.update();
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads + 1);
+    CHECK_EQUAL(expander.changedMask(), 0);
+
+    //A change asserts INT, so the next update reads the pins (which clears INT)
+    HostArduino::setI2CInputs(ADDRESS, pressed);
+    CHECK(!HostArduino::getPin(INT_PIN));
+    expander.update();
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads + 2);
+    CHECK(HostArduino::getPin(INT_PIN));
+    CHECK_EQUAL(expander.readAll(), pressed);
+    CHECK_EQUAL(expander.changedMask(), pressed ^ released);
+    expander.update();
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads + 2);
+    CHECK_EQUAL(expander.changedMask(), 0);
+    CHECK_EQUAL(expander.readAll(), pressed);
+
+    //Back to polling
+    expander.disableInterrupt();
+    HostArduino::setI2CInputs(ADDRESS, released);
+    expander.update();
+    CHECK_EQUAL(expander.readAll(), released);
+    expander.update();
+    CHECK_EQUAL(HostArduino::i2cReadCount(), reads + 4);
+}
+
+}
+
+int main() {
+    checkMcp23017();
+    checkPcf857x<AdafruitPCF8574ExpanderAdapter>(0xFB, 0xFF);
+    checkPcf857x<AdafruitPCF8575ExpanderAdapter>(0xFBFF, 0xFFFF);
+    checkPcf857x<RobTillaartPCF8575ExpanderAdapter>(0xFBFF, 0xFFFF);
+    return checkResult();
+}
@@ -0,0 +1,89 @@
+/**
+ * Check: readAll() and changedMask() of the I2C expander adapters.
+ *
+ * - readAll() has the same pins as read() and changedMask() the pins that changed on the last update(), for random
+ *   changes to every pin of the MCP23017, PCF8574 and PCF8575 adapters.
+ * - An ExpanderPinAdapter's hasChanged() is its own bit of the mask.
+ * - An adapter that only implements read() gets a readAll() from read() and reports that every pin may have changed.
+ */
+
+#include <Arduino.h>
+#include <GpioExpanderAdapter/AdafruitMCP23017ExpanderAdapter.h>
+#include <GpioExpanderAdapter/AdafruitPCF8574ExpanderAdapter.h>
+#include <GpioExpanderAdapter/AdafruitPCF8575ExpanderAdapter.h>
+#include <GpioExpanderAdapter/RobTillaartPCF8575ExpanderAdapter.h>
+#include <PinAdapter/ExpanderPinAdapter.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+const uint8_t ADDRESS = 0x20;
+
+template <typename Adapter>
+void checkMasks(uint8_t pinCount) {
+    HostArduino::reset();
+    uint32_t mask = ((uint32_t)1 << pinCount) - 1;
+    HostArduino::setI2CInputs(ADDRESS, (uint16_t)mask);
+    Adapter expander;
+    expander.begin(); //At the default address (0x20)
+    ExpanderPinAdapter* pins[16]; //Not deleted - the check exits shortly
+    for (uint8_t pin = 0; pin < pinCount; pin++) {
+        pins[pin] = new ExpanderPinAdapter(pin, expander);
+        pins[pin]->begin();
+    }
+    expander.update();
+    uint32_t previous = expander.readAll();
+    CHECK_EQUAL(previous, mask);
+    for (uint16_t i = 0; i < 500; i++) {
+        uint32_t inputs = previous;
+        for (uint8_t flips = rand() % 4; flips; flips--) {
+            inputs ^= (uint32_t)1 << (rand() % pinCount);
+        }
+        HostArduino::setI2CInputs(ADDRESS, (uint16_t)inputs);
+        expander.update();
+        CHECK_EQUAL(expander.readAll(), inputs);
+        CHECK_EQUAL(expander.changedMask(), inputs ^ previous);
+        for (uint8_t pin = 0; pin < pinCount; pin++) {
+            CHECK_EQUAL(expander.read(pin), (inputs >> pin) & 1);
+            CHECK_EQUAL(pins[pin]->hasChanged(), ((inputs ^ previous) >> pin) & 1);
+        }
+        previous = inputs;
+    }
+}
+
+/**
+ * An expander adapter with only read().
+ */
+class ReadOnlyExpanderAdapter : public GpioExpanderAdapter {
+public:
+    void begin() override {}
+    void update() override {}
+    bool read(byte pin) override { return (pins >> pin) & 1; }
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+    uint32_t pins = 0;
+};
+
+void checkDefaults() {
+    ReadOnlyExpanderAdapter expander;
+    ExpanderPinAdapter pin(5, expander);
+    for (uint16_t i = 0; i < 100; i++) {
+        expander.pins = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        CHECK_EQUAL(expander.readAll(), expander.pins);
+        CHECK_EQUAL(expander.changedMask(), 0xFFFFFFFF);
+        CHECK(pin.hasChanged());
+    }
+    CHECK(expander.pinChanged(40));
+}
+
+}
+
+int main() {
+    srand(12);
+    checkMasks<AdafruitMCP23017ExpanderAdapter>(16);
+    checkMasks<AdafruitPCF8574ExpanderAdapter>(8);
+    checkMasks<AdafruitPCF8575ExpanderAdapter>(16);
+    checkMasks<RobTillaartPCF8575ExpanderAdapter>(16);
+    checkDefaults();
+    return checkResult();
+}
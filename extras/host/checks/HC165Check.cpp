@@ -0,0 +1,184 @@
+/**
+ * Check: the 74HC165 adapters read the same pins as HC165ExpanderAdapter from a Host74HC165 cascade.
+ *
+ * - HC165SPIExpanderAdapter over the host SPI library.
+ * - HC165PortExpanderAdapter over (host) port registers. The clock port is only written with interrupts disabled and
+ *   the previous interrupt state is restored afterwards.
+ * - HC165CascadeExpanderAdapter with more than 4 chips (shifted in and with SPI): every word of pins, the changed
+ *   words and nextChanged().
+ */
+
+#include <Arduino.h>
+
+/*
+ * Host 'port registers' so HC165ShiftIn uses its port I/O path: each pin is a port of one bit and the register
+ * operations HC165ShiftIn uses are forwarded to digitalRead() and digitalWrite(), which drive the Host74HC165.
+ * Defined before the adapters are included as HC165ShiftIn checks for portInputRegister() and portOutputRegister().
+ */
+static uint32_t clockWritesWithInterrupts = 0;
+
+struct HostPortRegister {
+    uint8_t pin;
+    int operator&(int mask) const { return (mask & 1) ? digitalRead(pin) : 0; }
+    void operator|=(int mask) { write(mask & 1, HIGH); }
+    void operator&=(int mask) { write(!(mask & 1), LOW); }
+    void write(bool selected, uint8_t level) {
+        if ( !selected ) return;
+        if ( interruptsAreEnabled() ) clockWritesWithInterrupts++;
+        digitalWrite(pin, level);
+    }
+};
+
+static HostPortRegister hostPorts[HostArduino::MAX_PINS];
+
+static HostPortRegister* hostPort(uint8_t pin) {
+    hostPorts[pin].pin = pin;
+    return &hostPorts[pin];
+}
+
+#define digitalPinToPort(pin) (pin)
+#define digitalPinToBitMask(pin) ((uint8_t)1)
+#define portInputRegister(port) (hostPort(port))
+#define portOutputRegister(port) (hostPort(port))
+
+#include <GpioExpanderAdapter/HC165ExpanderAdapter.h>
+#include <GpioExpanderAdapter/HC165SPIExpanderAdapter.h>
+#include <GpioExpanderAdapter/HC165PortExpanderAdapter.h>
+#include <GpioExpanderAdapter/HC165CascadeExpanderAdapter.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+const uint8_t DATA_PIN = 4;
+const uint8_t CLOCK_PIN = 5;
+const uint8_t SHLD_PIN = 6;
+const uint8_t SPI_SHLD_PIN = 7;
+
+uint32_t randomWord() {
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+void checkAdapters() {
+    HostArduino::reset();
+    clockWritesWithInterrupts = 0;
+    for (uint8_t chips = 1; chips <= 4; chips++) {
+        Host74HC165 bitBanged(DATA_PIN, CLOCK_PIN, SHLD_PIN, chips);
+        Host74HC165 spiBus(MISO, SCK, SPI_SHLD_PIN, chips);
+        HC165ExpanderAdapter reference(DATA_PIN, CLOCK_PIN, SHLD_PIN, chips);
+        HC165PortExpanderAdapter port(DATA_PIN, CLOCK_PIN, SHLD_PIN, chips);
+        HC165SPIExpanderAdapter spi(SPI_SHLD_PIN, chips);
+        reference.begin();
+        port.begin();
+        spi.begin();
+        uint32_t mask = chips == 4 ? 0xFFFFFFFF : ((uint32_t)1 << (8 * chips)) - 1;
+        uint32_t previous = 0;
+        for (uint16_t i = 0; i < 200; i++) {
+            uint32_t inputs = randomWord();
+            bitBanged.setInputs(inputs);
+            spiBus.setInputs(inputs);
+            reference.update();
+            port.update();
+            spi.update();
+            CHECK_EQUAL(reference.readAll(), inputs & mask);
+            CHECK_EQUAL(port.readAll(), reference.readAll());
+            CHECK_EQUAL(spi.readAll(), reference.readAll());
+            if ( i > 0 ) {
+                CHECK_EQUAL(port.changedMask(), (inputs ^ previous) & mask);
+                CHECK_EQUAL(spi.changedMask(), (inputs ^ previous) & mask);
+            }
+            previous = inputs;
+        }
+    }
+    CHECK_EQUAL(clockWritesWithInterrupts, 0);
+}
+
+void checkInterruptState() {
+    HostArduino::reset();
+    Host74HC165 cascade(DATA_PIN, CLOCK_PIN, SHLD_PIN, 2);
+    HC165PortExpanderAdapter port(DATA_PIN, CLOCK_PIN, SHLD_PIN, 2);
+    port.begin();
+    cascade.setInputs(0xA55A);
+
+    port.update();
+    CHECK(interruptsAreEnabled());
+    CHECK_EQUAL(port.readAll(), 0xA55A);
+
+    //Called with interrupts disabled (eg from a timer ISR), they must not be enabled by the read
+    noInterrupts();
+    cascade.setInputs(0x5AA5);
+    port.update();
+    CHECK(!interruptsAreEnabled());
+    interrupts();
+    CHECK_EQUAL(port.readAll(), 0x5AA5);
+}
+
+template <uint8_t CHIPS>
+void checkCascade() {
+    typedef HC165CascadeExpanderAdapter<CHIPS> Cascade;
+    HostArduino::reset();
+    Host74HC165 bitBanged(DATA_PIN, CLOCK_PIN, SHLD_PIN, CHIPS);
+    Host74HC165 spiBus(MISO, SCK, SPI_SHLD_PIN, CHIPS);
+    Cascade shifted(DATA_PIN, CLOCK_PIN, SHLD_PIN);
+    Cascade spi(SPI_SHLD_PIN, SPI);
+    shifted.begin();
+    spi.begin();
+    Cascade* adapters[] = { &shifted, &spi };
+    uint32_t inputs[Cascade::WORD_COUNT] = {};
+    uint32_t previous[Cascade::WORD_COUNT] = {};
+    for (uint16_t i = 0; i < 100; i++) {
+        for (uint8_t w = 0; w < Cascade::WORD_COUNT; w++) {
+            //Mostly unchanged words, so nextChanged() has gaps to skip
+            previous[w] = inputs[w];
+            if ( i == 0 || rand() % 3 == 0 ) inputs[w] = randomWord();
+            uint8_t bits = (CHIPS - w * 4) >= 4 ? 32 : (CHIPS - w * 4) * 8;
+            if ( bits < 32 ) inputs[w] &= ((uint32_t)1 << bits) - 1;
+            bitBanged.setInputs(inputs[w], w);
+            spiBus.setInputs(inputs[w], w);
+        }
+        for (Cascade* adapter : adapters) {
+            adapter->update();
+            CHECK_EQUAL(adapter->readAll(), inputs[0]);
+            bool anyChanged = false;
+            uint16_t pin = adapter->nextChanged(0);
+            for (uint8_t w = 0; w < Cascade::WORD_COUNT; w++) {
+                CHECK_EQUAL(adapter->readWord(w), inputs[w]);
+                if ( i == 0 ) continue;
+                uint32_t changed = inputs[w] ^ previous[w];
+                CHECK_EQUAL(adapter->changedWord(w), changed);
+                anyChanged |= changed != 0;
+                //nextChanged() visits exactly the changed pins, in order
+                for (; changed; changed &= changed - 1) {
+                    CHECK_EQUAL(pin, w * 32 + __builtin_ctzl(changed));
+                    CHECK(adapter->pinChanged(pin));
+                    pin = adapter->nextChanged(pin + 1);
+                }
+            }
+            if ( i == 0 ) continue;
+            CHECK_EQUAL(pin, Cascade::PIN_COUNT);
+            CHECK_EQUAL(adapter->hasChanged(), anyChanged);
+        }
+    }
+    uint8_t bytes[CHIPS];
+    spi.copyBytes(bytes);
+    for (uint16_t pin = 0; pin < Cascade::PIN_COUNT; pin++) {
+        bool level = (inputs[pin >> 5] >> (pin & 31)) & 1;
+        CHECK_EQUAL(shifted.read(pin), level);
+        CHECK_EQUAL((bytes[pin >> 3] >> (pin & 7)) & 1, level);
+    }
+    if ( Cascade::PIN_COUNT < 256 ) CHECK(!shifted.read((byte)Cascade::PIN_COUNT));
+}
+
+}
+
+int main() {
+    srand(165);
+    checkAdapters();
+    checkInterruptState();
+    checkCascade<1>();
+    checkCascade<5>();
+    checkCascade<8>();
+    checkCascade<13>();
+    checkCascade<32>();
+    return checkResult();
+}
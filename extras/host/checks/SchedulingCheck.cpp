@@ -0,0 +1,135 @@
+/**
+ * Check: InputManager scheduling.
+ *
+ * - With scheduling, buttons, switches, an encoder and an analog input on GPIO pins fire exactly the same events (at
+ *   the same times) as with every input updated on every pass, from the default start time and across a millis()
+ *   rollover. Within a pass, changed inputs are updated before due ones so only the order of events with the same
+ *   timestamp may differ.
+ * - Scheduling skips the updates of inputs that have not changed and have no deadline.
+ */
+
+#include <Arduino.h>
+#include <EventButton.h>
+#include <EventSwitch.h>
+#include <EventEncoder.h>
+#include <EventAnalog.h>
+#include <InputManager.h>
+#include <EncoderAdapter/IEncoderAdapter.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "Check.h"
+
+namespace {
+
+const uint8_t BUTTON_COUNT = 6;
+const uint8_t FIRST_BUTTON_PIN = 2;
+const uint8_t SWITCH_PIN = 10;
+const uint8_t ANALOG_PIN = 14;
+
+std::vector<std::string> eventLog;
+
+void log(const char* input, uint8_t id, InputEventType et, long value) {
+    char line[48];
+    snprintf(line, sizeof(line), "%lu %s%u %u %ld\n", (unsigned long)millis(), input, id, (unsigned)et, value);
+    eventLog.push_back(line);
+}
+
+void onButton(InputEventType et, EventButton& ie) { log("b", ie.getInputId(), et, ie.clickCount()); }
+void onSwitch(InputEventType et, EventSwitch& ie) { log("s", ie.getInputId(), et, ie.isOn()); }
+void onEncoder(InputEventType et, EventEncoder& ie) { log("e", ie.getInputId(), et, ie.position()); }
+void onAnalog(InputEventType et, EventAnalog& ie) { log("a", ie.getInputId(), et, ie.position()); }
+
+/**
+ * An encoder adapter whose position is set by the check.
+ */
+class TestEncoderAdapter : public IEncoderAdapter {
+public:
+    bool begin() override { return true; }
+    int32_t getPosition() override { return position; }
+    void setPosition(int32_t pos) override { position = pos; }
+private:
+    int32_t position = 0;
+};
+
+/**
+ * The inputs driven by a random (but repeatable) walk for 30 seconds.
+ */
+std::vector<std::string> randomPanel(bool scheduled, uint32_t startMs) {
+    HostArduino::reset();
+    HostArduino::setMillis(startMs);
+    eventLog.clear();
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        HostArduino::setPin(FIRST_BUTTON_PIN + i, HIGH);
+    }
+    HostArduino::setPin(SWITCH_PIN, HIGH);
+    HostArduino::setAnalog(ANALOG_PIN, 512);
+    InputManager inputs;
+    EventButton* buttons[BUTTON_COUNT]; //Not deleted - the check exits shortly
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        buttons[i] = new EventButton(FIRST_BUTTON_PIN + i);
+        buttons[i]->begin();
+        buttons[i]->setInputId(i);
+        buttons[i]->setIdleTimeout(3000 + 500 * i);
+        buttons[i]->setCallback(onButton);
+        inputs.add(*buttons[i]);
+    }
+    EventSwitch toggle(SWITCH_PIN);
+    toggle.begin();
+    toggle.setCallback(onSwitch);
+    inputs.add(toggle);
+    TestEncoderAdapter encoderAdapter;
+    EventEncoder encoder(&encoderAdapter);
+    encoder.begin();
+    encoder.setRateLimit(20);
+    encoder.setCallback(onEncoder);
+    inputs.add(encoder);
+    EventAnalog analog(ANALOG_PIN);
+    analog.begin();
+    analog.setCallback(onAnalog);
+    inputs.add(analog);
+    inputs.enableScheduling(scheduled);
+
+    uint16_t pins = 0xFFFF;
+    int analogValue = 512;
+    srand(3);
+    for (uint32_t ms = 0; ms < 30000; ms++) {
+        if ( rand() % 60 == 0 ) {
+            uint8_t button = rand() % BUTTON_COUNT;
+            pins ^= 1 << button;
+            HostArduino::setPin(FIRST_BUTTON_PIN + button, (pins >> button) & 1);
+        }
+        if ( rand() % 2000 == 0 ) {
+            pins ^= 1 << 15;
+            HostArduino::setPin(SWITCH_PIN, (pins >> 15) & 1);
+        }
+        if ( rand() % 30 == 0 ) encoderAdapter.setPosition(encoderAdapter.getPosition() + (rand() % 2 ? 1 : -1));
+        if ( rand() % 200 == 0 ) {
+            analogValue = constrain(analogValue + (rand() % 201) - 100, 0, 1023);
+            HostArduino::setAnalog(ANALOG_PIN, analogValue);
+        }
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    CHECK(!scheduled || inputs.skippedCount() > 0);
+    std::sort(eventLog.begin(), eventLog.end());
+    return eventLog;
+}
+
+void checkScheduledMatchesUnscheduled() {
+    const uint32_t starts[] = { 0, 0xFFFFF000 };
+    for (uint32_t start : starts) {
+        std::vector<std::string> unscheduled = randomPanel(false, start);
+        std::vector<std::string> scheduled = randomPanel(true, start);
+        CHECK(unscheduled.size() > 500);
+        CHECK(scheduled == unscheduled);
+    }
+}
+
+}
+
+int main() {
+    checkScheduledMatchesUnscheduled();
+    return checkResult();
+}
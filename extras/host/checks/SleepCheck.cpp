@@ -0,0 +1,161 @@
+/**
+ * Check: InputManager::sleep().
+ *
+ * - setSleepAdapter() arms the pin of every input and canSleep() is false if any input cannot wake the MCU.
+ * - sleep() sleeps until the next deadline (or with no timeout when there is none) and does not sleep when a deadline
+ *   has already been reached.
+ * - With GpioSleepAdapter (host interrupts), a loop of update() and sleep() wakes on a pin change and at each deadline,
+ *   so it fires the same events as a loop that never sleeps with far fewer passes.
+ */
+
+#include <Arduino.h>
+#include <EventButton.h>
+#include <EventEncoder.h>
+#include <InputManager.h>
+#include <EncoderAdapter/IEncoderAdapter.h>
+#include <SleepAdapter/VirtualSleepAdapter.h>
+#include <SleepAdapter/GpioSleepAdapter.h>
+#include <string>
+#include "Check.h"
+
+namespace {
+
+const uint8_t BUTTON_PIN = 2;
+const uint8_t BUTTON2_PIN = 3;
+
+std::string eventLog;
+
+void onButton(InputEventType et, EventButton& ie) {
+    char line[32];
+    snprintf(line, sizeof(line), "%lu %u %u\n", (unsigned long)millis(), ie.getInputId(), (unsigned)et);
+    eventLog += line;
+}
+
+/**
+ * An encoder adapter with no pin to wake the MCU.
+ */
+class TestEncoderAdapter : public IEncoderAdapter {
+public:
+    bool begin() override { return true; }
+    int32_t getPosition() override { return 0; }
+    void setPosition(int32_t pos) override {}
+};
+
+void checkVirtualSleep() {
+    HostArduino::reset();
+    HostArduino::setPin(BUTTON_PIN, HIGH);
+    HostArduino::setPin(BUTTON2_PIN, HIGH);
+    InputManager inputs;
+    EventButton button(BUTTON_PIN);
+    EventButton button2(BUTTON2_PIN);
+    button.begin();
+    button2.begin();
+    button.setIdleTimeout(0xFFFF); //So only the LONG_PRESS deadline is pending while pressed
+    button2.setIdleTimeout(0xFFFF);
+    button.setCallback(onButton);
+    button2.setCallback(onButton);
+    inputs.add(button);
+    inputs.add(button2);
+    inputs.enableScheduling();
+    CHECK(!inputs.canSleep());
+    CHECK(!inputs.sleep());
+
+    VirtualSleepAdapter sleeper;
+    inputs.setSleepAdapter(&sleeper);
+    CHECK_EQUAL(sleeper.attachedPinCount(), 2);
+    CHECK(inputs.canSleep());
+
+    //Wait for the IDLE timeouts (which are deadlines) to pass, then there is nothing to wake for
+    for (uint32_t ms = 0; ms < 70000; ms++) {
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    inputs.update();
+    uint32_t deadlineMs;
+    CHECK(!inputs.nextDeadline(deadlineMs));
+    CHECK(inputs.sleep());
+    CHECK_EQUAL(sleeper.lastSleepMs(), SleepAdapter::NO_TIMEOUT);
+
+    //A press: sleep until the LONG_PRESS (or the debounce) deadline
+    HostArduino::setPin(BUTTON_PIN, LOW);
+    for (uint8_t ms = 0; ms < 50; ms++) {
+        inputs.update();
+        HostArduino::advanceMillis(1);
+    }
+    inputs.update();
+    CHECK(inputs.nextDeadline(deadlineMs));
+    CHECK(inputs.sleep());
+    CHECK_EQUAL(sleeper.lastSleepMs(), deadlineMs - millis());
+    CHECK(sleeper.lastSleepMs() > 0 && sleeper.lastSleepMs() < 1000);
+
+    //A deadline that has been reached is work to do, so no sleep
+    uint32_t sleeps = sleeper.sleepCount();
+    HostArduino::setMillis(deadlineMs);
+    CHECK(!inputs.sleep());
+    CHECK_EQUAL(sleeper.sleepCount(), sleeps);
+
+    //An input without a wake pin
+    TestEncoderAdapter encoderAdapter;
+    EventEncoder encoder(&encoderAdapter);
+    encoder.begin();
+    inputs.add(encoder);
+    CHECK(!inputs.canSleep());
+    CHECK(!inputs.sleep());
+    CHECK(inputs.remove(encoder));
+    CHECK(inputs.canSleep());
+
+    //A sleep adapter whose pins cannot wake the MCU
+    VirtualSleepAdapter noWake(false);
+    inputs.setSleepAdapter(&noWake);
+    CHECK(!inputs.canSleep());
+}
+
+/**
+ * Two clicks and a long press over 30 seconds, with update() called every ms or only when woken from sleep().
+ */
+std::string clicks(bool sleep, uint32_t& passes) {
+    HostArduino::reset();
+    HostArduino::setPin(BUTTON_PIN, HIGH);
+    eventLog.clear();
+    InputManager inputs;
+    EventButton button(BUTTON_PIN);
+    button.begin();
+    button.setIdleTimeout(5000);
+    button.setCallback(onButton);
+    inputs.add(button);
+    inputs.enableScheduling();
+    GpioSleepAdapter sleeper;
+    if ( sleep ) inputs.setSleepAdapter(&sleeper);
+    HostArduino::schedulePin(3000, BUTTON_PIN, LOW);
+    HostArduino::schedulePin(3100, BUTTON_PIN, HIGH);
+    HostArduino::schedulePin(12000, BUTTON_PIN, LOW);
+    HostArduino::schedulePin(12080, BUTTON_PIN, HIGH);
+    HostArduino::schedulePin(20000, BUTTON_PIN, LOW);
+    HostArduino::schedulePin(22000, BUTTON_PIN, HIGH);
+    HostArduino::schedulePin(30000, BUTTON_PIN, LOW); //Nothing else would wake the last sleep
+    passes = 0;
+    while ( millis() < 30000 ) {
+        inputs.update();
+        passes++;
+        if ( !sleep || !inputs.sleep() ) HostArduino::advanceMillis(1);
+    }
+    return eventLog;
+}
+
+void checkGpioSleep() {
+    uint32_t awakePasses;
+    uint32_t sleepPasses;
+    std::string awake = clicks(false, awakePasses);
+    std::string asleep = clicks(true, sleepPasses);
+    CHECK(awake.size() > 0);
+    CHECK(asleep == awake);
+    CHECK(sleepPasses < awakePasses / 100);
+}
+
+}
+
+int main() {
+    checkVirtualSleep();
+    checkGpioSleep();
+    return checkResult();
+}
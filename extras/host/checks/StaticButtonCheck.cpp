@@ -0,0 +1,97 @@
+/**
+ * Check: StaticEventButton fires the same events (at the same times, with the same click and long press counts) as
+ * EventButton with its default debouncer, for a random (but repeatable) walk of presses, bounces and long presses.
+ */
+
+#include <Arduino.h>
+#include <EventButton.h>
+#include <StaticEventButton.h>
+#include <stdlib.h>
+#include <string>
+#include <algorithm>
+#include "Check.h"
+
+namespace {
+
+const uint8_t BUTTON_PIN = 2;
+const uint8_t STATIC_BUTTON_PIN = 3;
+
+std::string eventLog;
+std::string staticEventLog;
+uint32_t typesFired = 0;
+
+void logEvent(std::string& log, InputEventType et, uint8_t clicks, uint16_t longPresses) {
+    char line[40];
+    snprintf(line, sizeof(line), "%lu %u %u %u\n", (unsigned long)millis(), (unsigned)et, clicks, longPresses);
+    log += line;
+}
+
+void onButton(InputEventType et, EventButton& ie) {
+    typesFired |= bit((uint8_t)et);
+    logEvent(eventLog, et, ie.clickCount(), ie.longPressCount());
+}
+
+struct StaticHandler {
+    template <typename Button>
+    static void onEvent(InputEventType et, Button& button) {
+        logEvent(staticEventLog, et, button.clickCount(), button.longPressCount());
+    }
+};
+
+void checkSameEvents(bool repeatLongPress) {
+    HostArduino::reset();
+    HostArduino::setPin(BUTTON_PIN, HIGH);
+    HostArduino::setPin(STATIC_BUTTON_PIN, HIGH);
+    eventLog.clear();
+    staticEventLog.clear();
+    typesFired = 0;
+    EventButton button(BUTTON_PIN);
+    StaticEventButton<StaticGpioPin<STATIC_BUTTON_PIN>, StaticFoltmanDebouncer<10>, StaticHandler> staticButton;
+    button.begin();
+    staticButton.begin();
+    button.setCallback(onButton);
+    button.setIdleTimeout(4000);
+    staticButton.setIdleTimeout(4000);
+    button.enableLongPressRepeat(repeatLongPress);
+    staticButton.enableLongPressRepeat(repeatLongPress);
+
+    bool level = HIGH;
+    uint32_t nextChangeMs = 0;
+    srand(8);
+    for (uint32_t ms = 0; ms < 300000; ms++) {
+        if ( ms == nextChangeMs ) {
+            level = !level;
+            //Short bounces, clicks, long clicks and pauses long enough for IDLE
+            switch ( rand() % 5 ) {
+                case 0: nextChangeMs = ms + 1 + rand() % 8; break;
+                case 1: nextChangeMs = ms + 20 + rand() % 200; break;
+                case 2: nextChangeMs = ms + 200 + rand() % 400; break;
+                case 3: nextChangeMs = ms + 600 + rand() % 2000; break;
+                default: nextChangeMs = ms + 3000 + rand() % 3000; break;
+            }
+            HostArduino::setPin(BUTTON_PIN, level);
+            HostArduino::setPin(STATIC_BUTTON_PIN, level);
+        }
+        button.update();
+        staticButton.update();
+        CHECK_EQUAL(staticButton.isPressed(), button.isPressed());
+        HostArduino::advanceMillis(1);
+    }
+    CHECK(std::count(eventLog.begin(), eventLog.end(), '\n') > 200);
+    //Every kind of button event was fired
+    const InputEventType types[] = { InputEventType::PRESSED, InputEventType::RELEASED, InputEventType::CLICKED,
+        InputEventType::DOUBLE_CLICKED, InputEventType::MULTI_CLICKED, InputEventType::LONG_CLICKED,
+        InputEventType::LONG_PRESS, InputEventType::IDLE };
+    for (InputEventType et : types) {
+        CHECK(typesFired & bit((uint8_t)et));
+    }
+    CHECK(staticEventLog == eventLog);
+}
+
+}
+
+int main() {
+    checkSameEvents(true);
+    checkSameEvents(false);
+    return checkResult();
+}
@@ -0,0 +1,147 @@
+/**
+ * Check: TimerWheel.
+ *
+ * - Random schedules, reschedules and cancels (from 1ms to over three minutes ahead, so deadlines cascade down the
+ *   levels and are parked beyond the wheel) and random advances: after each advance exactly the inputs whose deadline
+ *   has been reached are due (so none early and none late), and nextDeadline() and count() match the rest.
+ * - From zero and across a millis() rollover.
+ * - A deadline scheduled before a parked one is found by nextDeadline() even when it is in an earlier top level slot.
+ */
+
+#include <Arduino.h>
+#include <TimerWheel.h>
+#include <EventSwitch.h>
+#include <PinAdapter/VirtualPinAdapter.h>
+#include <stdlib.h>
+#include "Check.h"
+
+namespace {
+
+const uint8_t INPUT_COUNT = 48;
+
+EventSwitch* inputs[INPUT_COUNT]; //Not deleted - the check exits shortly
+bool scheduled[INPUT_COUNT] = {};
+uint32_t deadlines[INPUT_COUNT] = {};
+
+void createInputs() {
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        inputs[i] = new EventSwitch(new VirtualPinAdapter());
+    }
+}
+
+uint32_t randomAhead() {
+    switch ( rand() % 4 ) {
+        case 0: return rand() % 16;
+        case 1: return rand() % 4096;
+        case 2: return rand() % 65536;
+        default: return rand() % 200000; //Parked beyond the wheel
+    }
+}
+
+uint32_t randomStep() {
+    switch ( rand() % 4 ) {
+        case 0: return 1;
+        case 1: return rand() % 64;
+        case 2: return rand() % 5000;
+        default: return rand() % 70000;
+    }
+}
+
+/**
+ * Compare the wheel with the scheduled[] and deadlines[] model at nowMs.
+ */
+void checkWheel(TimerWheel& wheel, uint32_t nowMs) {
+    uint16_t waiting = 0;
+    bool found = false;
+    uint32_t earliest = 0;
+    uint8_t due = 0;
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        CHECK_EQUAL(TimerWheel::isScheduled(*inputs[i]), scheduled[i]);
+        if ( !scheduled[i] ) continue;
+        bool reached = !InputEventsClock::isBefore(nowMs, deadlines[i]);
+        CHECK_EQUAL(TimerWheel::isDue(*inputs[i]), reached);
+        if ( reached ) {
+            due++;
+            continue;
+        }
+        waiting++;
+        if ( !found || InputEventsClock::isBefore(deadlines[i], earliest) ) earliest = deadlines[i];
+        found = true;
+    }
+    CHECK_EQUAL(wheel.count(), waiting);
+    uint32_t deadlineMs = 0;
+    CHECK_EQUAL(wheel.nextDeadline(deadlineMs), found);
+    if ( found ) CHECK_EQUAL(deadlineMs, earliest);
+    uint8_t listed = 0;
+    for (EventInputBase* in = wheel.firstDue(); in; in = TimerWheel::nextDue(*in)) {
+        CHECK(TimerWheel::isDue(*in));
+        listed++;
+    }
+    CHECK_EQUAL(listed, due);
+}
+
+void checkRandom(uint32_t startMs) {
+    TimerWheel wheel;
+    wheel.begin(startMs);
+    uint32_t nowMs = startMs;
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        scheduled[i] = false;
+    }
+    for (uint16_t pass = 0; pass < 20000; pass++) {
+        for (uint8_t changes = rand() % 4; changes; changes--) {
+            uint8_t i = rand() % INPUT_COUNT;
+            if ( rand() % 5 == 0 ) {
+                wheel.cancel(*inputs[i]);
+                scheduled[i] = false;
+            } else {
+                deadlines[i] = nowMs + randomAhead();
+                wheel.schedule(*inputs[i], deadlines[i]);
+                scheduled[i] = true;
+            }
+        }
+        checkWheel(wheel, nowMs);
+        nowMs += randomStep();
+        wheel.advance(nowMs);
+        checkWheel(wheel, nowMs);
+    }
+    for (uint8_t i = 0; i < INPUT_COUNT; i++) {
+        wheel.cancel(*inputs[i]);
+    }
+    CHECK_EQUAL(wheel.count(), 0);
+    CHECK(wheel.firstDue() == nullptr);
+}
+
+void checkParked() {
+    TimerWheel wheel;
+    wheel.begin(0);
+    wheel.advance(30000);
+    wheel.schedule(*inputs[0], 130000); //Beyond the wheel, so parked
+    wheel.advance(40000);
+    wheel.schedule(*inputs[1], 100000);
+    uint32_t deadlineMs = 0;
+    CHECK(wheel.nextDeadline(deadlineMs));
+    CHECK_EQUAL(deadlineMs, 100000);
+    wheel.advance(99999);
+    CHECK(!TimerWheel::isDue(*inputs[1]));
+    wheel.advance(100000);
+    CHECK(TimerWheel::isDue(*inputs[1]));
+    CHECK(wheel.nextDeadline(deadlineMs));
+    CHECK_EQUAL(deadlineMs, 130000);
+    wheel.advance(129999);
+    CHECK(!TimerWheel::isDue(*inputs[0]));
+    wheel.advance(130000);
+    CHECK(TimerWheel::isDue(*inputs[0]));
+    wheel.cancel(*inputs[0]);
+    wheel.cancel(*inputs[1]);
+}
+
+}
+
+int main() {
+    srand(5);
+    createInputs();
+    checkRandom(0);
+    checkRandom(0xFFF00000);
+    checkParked();
+    return checkResult();
+}
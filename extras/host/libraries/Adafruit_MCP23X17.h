@@ -0,0 +1,96 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_ADAFRUIT_MCP23X17_H
+#define INPUT_EVENTS_HOST_ADAFRUIT_MCP23X17_H
+
+#include "HostI2CExpander.h"
+
+/*
+ * A host mock of Adafruit's MCP23X17 (https://github.com/adafruit/Adafruit-MCP23017-Arduino-Library).
+ *
+ * Interrupt on change is modelled per port with INTA/INTB mirrored: once setupInterrupts() has been called, the first
+ * change to an input set up with setupInterruptPin() flags its port (INTF), captures that port's inputs (INTCAP) and
+ * asserts INT on the pin set with HostArduino::setI2CInterruptPin(). The other port's INTCAP is only captured by its
+ * own interrupt. Reading the pins or the captured inputs clears both ports.
+ */
+class Adafruit_MCP23X17 : public HostI2CExpander {
+public:
+    bool begin_I2C(uint8_t i2c_addr = 0x20, TwoWire* wire = &Wire) { return beginAt(i2c_addr); }
+    void pinMode(uint8_t pin, uint8_t mode) { setPinMode(pin, mode); }
+    uint8_t digitalRead(uint8_t pin) { return readPin(pin); }
+    void digitalWrite(uint8_t pin, uint8_t value) { writePin(pin, value); }
+    uint8_t readGPIOA() { return readGPIOAB() & 0xFF; }
+    uint8_t readGPIOB() { return readGPIOAB() >> 8; }
+    uint16_t readGPIOAB() {
+        uint16_t value = readAll();
+        clearInt();
+        return value;
+    }
+
+    void setupInterrupts(bool mirroring, bool openDrain, uint8_t polarity) {
+        if ( !interrupts ) HostArduino::addI2CListener(address, &onMcpInputsChanged, this);
+        interrupts = true;
+        intPolarity = polarity;
+        lastInputs = HostArduino::getI2CInputs(address);
+        clearInt();
+    }
+    void setupInterruptPin(uint8_t pin, uint8_t mode = CHANGE) { intEnabled |= (1U << pin); }
+    void disableInterruptPin(uint8_t pin) { intEnabled &= ~(1U << pin); }
+    uint8_t getLastInterruptPin() {
+        HostArduino::countI2CRead();
+        if ( !intFlags ) return 255;
+        return (intFlags & 0x00FF) ? (uint8_t)__builtin_ctz(intFlags & 0x00FF) : (uint8_t)__builtin_ctz(intFlags);
+    }
+    uint16_t getCapturedInterrupt() {
+        HostArduino::countI2CRead();
+        clearInt();
+        return intCap;
+    }
+    void clearInterrupts() { getCapturedInterrupt(); }
+
+private:
+    bool interrupts = false;
+    uint8_t intPolarity = LOW;
+    uint16_t intEnabled = 0;
+    uint16_t intFlags = 0; // INTFB:INTFA - the pin that caused each port's interrupt
+    uint16_t intCap = 0xFFFF; // INTCAPB:INTCAPA
+    uint16_t lastInputs = 0xFFFF;
+
+    static void onMcpInputsChanged(uint8_t, void* context) {
+        static_cast<Adafruit_MCP23X17*>(context)->inputsChanged();
+    }
+
+    void inputsChanged() {
+        uint16_t inputs = HostArduino::getI2CInputs(address);
+        uint16_t changed = (inputs ^ lastInputs) & intEnabled & ~outputMask;
+        lastInputs = inputs;
+        uint16_t pins = (inputs & ~outputMask) | (outputs & outputMask);
+        bool captured = false;
+        for (uint16_t port = 0x00FF; port; port <<= 8) {
+            // Each port's INTCAP only captures its first change until the interrupt is cleared
+            if ( !(changed & port) || (intFlags & port) ) continue;
+            intFlags |= 1U << __builtin_ctz(changed & port);
+            intCap = (intCap & ~port) | (pins & port);
+            captured = true;
+        }
+        if ( captured ) setInt(true);
+    }
+
+    void clearInt() {
+        intFlags = 0;
+        if ( interrupts ) setInt(false);
+    }
+
+    void setInt(bool active) {
+        uint8_t pin = HostArduino::getI2CInterruptPin(address);
+        if ( pin != HostArduino::NO_PIN ) HostArduino::setPin(pin, active == (intPolarity == HIGH));
+    }
+};
+
+#endif
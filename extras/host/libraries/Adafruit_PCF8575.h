@@ -0,0 +1,30 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_ADAFRUIT_PCF8575_H
+#define INPUT_EVENTS_HOST_ADAFRUIT_PCF8575_H
+
+#include "HostI2CExpander.h"
+
+/*
+ * A host mock of Adafruit's PCF8575 (https://github.com/adafruit/Adafruit_PCF8574).
+ */
+class Adafruit_PCF8575 : public HostI2CExpander {
+public:
+    bool begin(uint8_t i2c_addr = 0x20, TwoWire* wire = &Wire) {
+        beginAt(i2c_addr);
+        watchInputs();
+        return true;
+    }
+    bool pinMode(uint8_t pin, uint8_t mode) { setPinMode(pin, mode); return true; }
+    bool digitalRead(uint8_t pin) { return readPin(pin); }
+    bool digitalWrite(uint8_t pin, bool value) { writePin(pin, value); return true; }
+    uint16_t digitalReadWord() { return readAll(); }
+};
+
+#endif
@@ -0,0 +1,75 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef Encoder_h_
+#define Encoder_h_
+
+#include "Arduino.h"
+
+/*
+ * A host mock of PJRC's Encoder library (https://github.com/PaulStoffregen/Encoder).
+ * Pin changes made with HostArduino::setPin() are decoded as they happen, in the
+ * same way as the interrupt driven library.
+ */
+class Encoder {
+public:
+    Encoder(uint8_t pin1, uint8_t pin2) : pin1(pin1), pin2(pin2) {
+        pinMode(pin1, INPUT_PULLUP);
+        pinMode(pin2, INPUT_PULLUP);
+        state = readPins();
+        HostArduino::addPinListener(pin1, &onPinChange, this);
+        HostArduino::addPinListener(pin2, &onPinChange, this);
+    }
+
+    ~Encoder() {
+        HostArduino::removePinListeners(this);
+    }
+
+    int32_t read() { return position; }
+
+    int32_t readAndReset() {
+        int32_t ret = position;
+        position = 0;
+        return ret;
+    }
+
+    void write(int32_t p) { position = p; }
+
+private:
+    uint8_t pin1;
+    uint8_t pin2;
+    uint8_t state;
+    int32_t position = 0;
+
+    uint8_t readPins() {
+        return (digitalRead(pin1) ? 1 : 0) | (digitalRead(pin2) ? 2 : 0);
+    }
+
+    static void onPinChange(uint8_t pin, void* context) {
+        Encoder* enc = static_cast<Encoder*>(context);
+        uint8_t s = enc->state | (enc->readPins() << 2);
+        enc->state = s >> 2;
+        // The same transition table as PJRC's Encoder::update()
+        switch (s) {
+        case 1: case 7: case 8: case 14:
+            enc->position++;
+            return;
+        case 2: case 4: case 11: case 13:
+            enc->position--;
+            return;
+        case 3: case 12:
+            enc->position += 2;
+            return;
+        case 6: case 9:
+            enc->position -= 2;
+            return;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_ASYNC_I2C_BUS_H
+#define INPUT_EVENTS_HOST_ASYNC_I2C_BUS_H
+
+#include "Arduino.h"
+#include "GpioExpanderAdapter/AsyncI2CBus.h"
+
+/*
+ * A host mock of an asynchronous I2C bus. A read samples HostArduino::getI2CInputs(address)
+ * (first byte is the low byte) when it starts and completes transferMicros later in virtual
+ * time, so a sketch sees the same latency as on a real bus. The register is ignored.
+ * failNext() makes the next reads fail, eg to model a missing device.
+ */
+class HostAsyncI2CBus : public AsyncI2CBus {
+public:
+    explicit HostAsyncI2CBus(uint32_t transferMicros = 300) : transferUs(transferMicros) {}
+
+    bool startRead(uint8_t address, uint8_t length, int16_t reg = NO_REGISTER) override {
+        if ( state != Status::IDLE ) return false;
+        HostArduino::countI2CRead();
+        uint32_t inputs = HostArduino::getI2CInputs(address) | 0xFFFF0000;
+        count = length > MAX_LENGTH ? MAX_LENGTH : length;
+        for (uint8_t i = 0; i < count; i++) {
+            data[i] = (uint8_t)(inputs >> (8 * i));
+        }
+        failing = failCount > 0;
+        if ( failing ) failCount--;
+        startUs = micros();
+        state = Status::BUSY;
+        transfers++;
+        return true;
+    }
+
+    Status status() override {
+        if ( state == Status::BUSY && micros() - startUs >= transferUs ) {
+            state = failing ? Status::FAILED : Status::DONE;
+        }
+        return state;
+    }
+
+    uint8_t takeData(uint8_t* buffer) override {
+        if ( status() == Status::BUSY ) return 0;
+        uint8_t length = state == Status::DONE ? count : 0;
+        for (uint8_t i = 0; i < length; i++) {
+            buffer[i] = data[i];
+        }
+        state = Status::IDLE;
+        return length;
+    }
+
+    void setTransferMicros(uint32_t us) { transferUs = us; }
+    void failNext(uint8_t reads = 1) { failCount = reads; }
+    uint32_t transferCount() { return transfers; }
+
+private:
+    uint32_t transferUs;
+    Status state = Status::IDLE;
+    uint8_t data[MAX_LENGTH];
+    uint8_t count = 0;
+    uint32_t startUs = 0;
+    uint8_t failCount = 0;
+    bool failing = false;
+    uint32_t transfers = 0;
+};
+
+#endif
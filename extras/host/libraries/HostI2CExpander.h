@@ -0,0 +1,83 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_I2C_EXPANDER_H
+#define INPUT_EVENTS_HOST_I2C_EXPANDER_H
+
+#include "Arduino.h"
+#include "Wire.h"
+
+/*
+ * The common part of the host I2C GPIO expander mocks. Inputs are read from
+ * HostArduino::getI2CInputs(address) and every read is counted
+ * (HostArduino::i2cReadCount()). Pins set as OUTPUT read back the last value written.
+ *
+ * The PCF857x mocks call watchInputs() in begin() to model the PCF's INT line: it is asserted (LOW) on the pin set
+ * with HostArduino::setI2CInterruptPin() while the inputs differ from the last read.
+ */
+class HostI2CExpander {
+public:
+    explicit HostI2CExpander(uint8_t address = 0x20) : address(address) {}
+    ~HostI2CExpander() { HostArduino::removeI2CListeners(this); }
+
+protected:
+    uint8_t address;
+    uint16_t outputMask = 0;
+    uint16_t outputs = 0xFFFF;
+    bool watching = false;
+    uint16_t lastRead = 0xFFFF;
+
+    bool beginAt(uint8_t addr) {
+        address = addr;
+        return true;
+    }
+
+    uint16_t readAll() {
+        HostArduino::countI2CRead();
+        lastRead = HostArduino::getI2CInputs(address);
+        if ( watching ) setPin(HostArduino::getI2CInterruptPin(address), HIGH);
+        return (lastRead & ~outputMask) | (outputs & outputMask);
+    }
+
+    void watchInputs() {
+        if ( !watching ) HostArduino::addI2CListener(address, &onInputsChanged, this);
+        watching = true;
+        lastRead = HostArduino::getI2CInputs(address);
+        setPin(HostArduino::getI2CInterruptPin(address), HIGH);
+    }
+
+    bool readPin(uint8_t pin) { return (readAll() >> pin) & 1; }
+
+    void setPinMode(uint8_t pin, uint8_t mode) {
+        if ( mode == OUTPUT ) {
+            outputMask |= (1U << pin);
+        } else {
+            outputMask &= ~(1U << pin);
+        }
+    }
+
+    static void onInputsChanged(uint8_t address, void* context) {
+        HostI2CExpander* expander = static_cast<HostI2CExpander*>(context);
+        bool changed = HostArduino::getI2CInputs(address) != expander->lastRead;
+        setPin(HostArduino::getI2CInterruptPin(address), !changed);
+    }
+
+    static void setPin(uint8_t pin, bool level) {
+        if ( pin != HostArduino::NO_PIN ) HostArduino::setPin(pin, level);
+    }
+
+    void writePin(uint8_t pin, uint8_t value) {
+        if ( value ) {
+            outputs |= (1U << pin);
+        } else {
+            outputs &= ~(1U << pin);
+        }
+    }
+};
+
+#endif
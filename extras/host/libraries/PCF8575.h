@@ -0,0 +1,33 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HOST_PCF8575_H
+#define INPUT_EVENTS_HOST_PCF8575_H
+
+#include "HostI2CExpander.h"
+
+/*
+ * A host mock of Rob Tillaart's PCF8575 (https://github.com/RobTillaart/PCF8575).
+ */
+class PCF8575 : public HostI2CExpander {
+public:
+    explicit PCF8575(uint8_t deviceAddress = 0x20, TwoWire* wire = &Wire) : HostI2CExpander(deviceAddress) {}
+    bool begin(uint16_t value = 0xFFFF) {
+        outputs = value;
+        watchInputs();
+        return true;
+    }
+    bool isConnected() { return true; }
+    // Quasi-bidirectional: a pin written LOW reads LOW
+    uint16_t read16() { return readAll() & outputs; }
+    uint8_t read(uint8_t pin) { return (read16() >> pin) & 1; }
+    void write16(uint16_t value) { outputs = value; }
+    void write(uint8_t pin, uint8_t value) { writePin(pin, value); }
+};
+
+#endif
@@ -0,0 +1,29 @@
+# Run a host sketch against a script and compare its output with the expected output.
+#
+#   cmake -DSKETCH=<sketch> -DSCRIPT=<script> -DEXPECTED=<expected> -DOUTPUT=<actual> [-DSTART=<startMs>] -P CompareOutput.cmake
+#
+# The actual output is written to OUTPUT so a failure can be diffed.
+
+set(args "")
+if(DEFINED START)
+    list(APPEND args -s ${START})
+endif()
+
+execute_process(
+    COMMAND "${SKETCH}" ${args} "${SCRIPT}"
+    OUTPUT_VARIABLE actual
+    RESULT_VARIABLE result
+)
+file(WRITE "${OUTPUT}" "${actual}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${SKETCH} exited with ${result}")
+endif()
+
+file(READ "${EXPECTED}" expected)
+if(NOT actual STREQUAL expected)
+    find_program(DIFF diff)
+    if(DIFF)
+        execute_process(COMMAND "${DIFF}" -u "${EXPECTED}" "${OUTPUT}")
+    endif()
+    message(FATAL_ERROR "The output of ${SKETCH} differs from ${EXPECTED} (actual output in ${OUTPUT})")
+endif()
@@ -0,0 +1,242 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+/*
+ * Runs an Arduino sketch's setup() and loop() on the host against the virtual
+ * clock, driving pins, the ADC and I2C expanders from a script.
+ *
+ * Usage: <sketch> [-t durationMs] [-s startMs] [-u loopStepUs] [-v] [script|-]
+ *
+ * Script lines (times are milliseconds after startMs, numbers may be hex):
+ *
+ *   # A comment
+ *   <ms> pin <pin> <0|1>
+ *   <ms> analog <pin> <value>
+ *   <ms> i2c <address> <value>
+ *   <ms> hc165 <value> [word]
+ *   <ms> key <index> <0|1>
+ *   <ms> end
+ *   hc165 <dataPin> <clockPin> <shldPin> [cascadeLength]
+ *   i2cint <address> <pin>
+ *   keymatrix <firstRowPin> <rows> <firstColumnPin> <columns>
+ *
+ * 'hc165 <pins>' attaches a Host74HC165 to the sketch's pins, 'i2cint'
+ * connects the INT line of the I2C expander at address to a pin and 'keymatrix'
+ * attaches a HostKeyMatrix to consecutive row and column pins. Without an 'end'
+ * line (or -t) the sketch runs until 1000ms after the last scripted change.
+ */
+
+#include <Arduino.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+void setup();
+void loop();
+
+namespace {
+
+    enum class Command { PIN, ANALOG, I2C, HC165, KEY };
+
+    struct ScriptEvent {
+        uint32_t atMs;
+        Command command;
+        uint8_t target;
+        uint32_t value;
+    };
+
+    std::vector<ScriptEvent> events;
+    Host74HC165* shiftRegister = nullptr;
+    HostKeyMatrix* keyMatrix = nullptr;
+    bool verbose = false;
+
+    const char* commandName(Command c) {
+        switch (c) {
+        case Command::PIN: return "pin";
+        case Command::ANALOG: return "analog";
+        case Command::I2C: return "i2c";
+        case Command::HC165: return "hc165";
+        default: return "key";
+        }
+    }
+
+    void apply(void* context, uint32_t) {
+        const ScriptEvent& e = *static_cast<ScriptEvent*>(context);
+        if ( verbose ) {
+            fflush(stdout);
+            fprintf(stderr, "[%lu] %s %u 0x%X\n", millis(), commandName(e.command), e.target, e.value);
+        }
+        switch (e.command) {
+        case Command::PIN: HostArduino::setPin(e.target, e.value != 0); break;
+        case Command::ANALOG: HostArduino::setAnalog(e.target, (int)e.value); break;
+        case Command::I2C: HostArduino::setI2CInputs(e.target, (uint16_t)e.value); break;
+        case Command::HC165: if ( shiftRegister ) shiftRegister->setInputs(e.value, e.target); break;
+        case Command::KEY: if ( keyMatrix ) keyMatrix->setKey((uint16_t)e.value, e.target != 0); break;
+        }
+    }
+
+    void finish(void*, uint32_t) {
+        // Also ends sketches that never return from loop(), eg while sleeping
+        Serial.flush();
+        exit(0);
+    }
+
+    bool parseNumber(const char* s, uint32_t& n) {
+        if ( !s ) return false;
+        char* end;
+        n = (uint32_t)strtoul(s, &end, 0);
+        return *end == '\0';
+    }
+
+    bool loadScript(FILE* f, bool& hasEnd, uint32_t& endMs) {
+        char line[256];
+        int lineNumber = 0;
+        while ( fgets(line, sizeof(line), f) ) {
+            lineNumber++;
+            char* hash = strchr(line, '#');
+            if ( hash ) *hash = '\0';
+            const char* word[6] = {};
+            int words = 0;
+            for (char* tok = strtok(line, " \t\r\n"); tok && words < 6; tok = strtok(nullptr, " \t\r\n")) {
+                word[words++] = tok;
+            }
+            if ( words == 0 ) continue;
+            uint32_t n[4] = {};
+            if ( strcmp(word[0], "hc165") == 0 && words >= 4 ) {
+                bool ok = parseNumber(word[1], n[0]) && parseNumber(word[2], n[1]) && parseNumber(word[3], n[2]);
+                if ( words > 4 ) ok = ok && parseNumber(word[4], n[3]); else n[3] = 1;
+                if ( ok && !shiftRegister ) {
+                    shiftRegister = new Host74HC165(n[0], n[1], n[2], n[3]);
+                    continue;
+                }
+            } else if ( strcmp(word[0], "keymatrix") == 0 && words == 5 ) {
+                bool ok = parseNumber(word[1], n[0]) && parseNumber(word[2], n[1])
+                    && parseNumber(word[3], n[2]) && parseNumber(word[4], n[3]);
+                if ( ok && !keyMatrix ) {
+                    keyMatrix = new HostKeyMatrix(n[0], n[1], n[2], n[3]);
+                    continue;
+                }
+            } else if ( strcmp(word[0], "i2cint") == 0 && words == 3 ) {
+                if ( parseNumber(word[1], n[0]) && parseNumber(word[2], n[1]) ) {
+                    HostArduino::setI2CInterruptPin((uint8_t)n[0], (uint8_t)n[1]);
+                    continue;
+                }
+            } else if ( words >= 2 && parseNumber(word[0], n[0]) ) {
+                if ( strcmp(word[1], "end") == 0 ) {
+                    hasEnd = true;
+                    endMs = n[0];
+                    continue;
+                }
+                ScriptEvent e = { n[0], Command::PIN, 0, 0 };
+                bool ok = false;
+                if ( strcmp(word[1], "hc165") == 0 && (words == 3 || words == 4) ) {
+                    e.command = Command::HC165;
+                    ok = parseNumber(word[2], e.value);
+                    if ( words == 4 ) {
+                        ok = ok && parseNumber(word[3], n[1]);
+                        e.target = (uint8_t)n[1];
+                    }
+                } else if ( strcmp(word[1], "key") == 0 && words == 4 ) {
+                    // The key index can be more than 255 so is the value, the target is pressed (1) or released (0)
+                    e.command = Command::KEY;
+                    ok = parseNumber(word[2], e.value) && parseNumber(word[3], n[1]);
+                    e.target = n[1] != 0;
+                } else if ( words == 4 && parseNumber(word[2], n[1]) && parseNumber(word[3], e.value) ) {
+                    e.target = (uint8_t)n[1];
+                    ok = true;
+                    if ( strcmp(word[1], "analog") == 0 ) {
+                        e.command = Command::ANALOG;
+                    } else if ( strcmp(word[1], "i2c") == 0 ) {
+                        e.command = Command::I2C;
+                    } else {
+                        ok = strcmp(word[1], "pin") == 0;
+                    }
+                }
+                if ( ok ) {
+                    events.push_back(e);
+                    continue;
+                }
+            }
+            fprintf(stderr, "Script line %d not understood\n", lineNumber);
+            return false;
+        }
+        return true;
+    }
+
+    void usage(const char* name) {
+        fprintf(stderr, "Usage: %s [-t durationMs] [-s startMs] [-u loopStepUs] [-v] [script|-]\n", name);
+    }
+
+}
+
+int main(int argc, char** argv) {
+    uint32_t startMs = 0;
+    uint32_t stepUs = 100;
+    uint32_t durationMs = 0;
+    bool hasDuration = false;
+    const char* scriptPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        uint32_t* option = nullptr;
+        if ( strcmp(argv[i], "-t") == 0 ) {
+            option = &durationMs;
+            hasDuration = true;
+        } else if ( strcmp(argv[i], "-s") == 0 ) {
+            option = &startMs;
+        } else if ( strcmp(argv[i], "-u") == 0 ) {
+            option = &stepUs;
+        } else if ( strcmp(argv[i], "-v") == 0 ) {
+            verbose = true;
+            continue;
+        } else if ( !scriptPath && (argv[i][0] != '-' || argv[i][1] == '\0') ) {
+            scriptPath = argv[i];
+            continue;
+        }
+        if ( !option || ++i >= argc || !parseNumber(argv[i], *option) ) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if ( stepUs == 0 ) stepUs = 1;
+
+    bool hasEnd = false;
+    uint32_t endMs = 0;
+    if ( scriptPath ) {
+        FILE* f = strcmp(scriptPath, "-") == 0 ? stdin : fopen(scriptPath, "r");
+        if ( !f ) {
+            perror(scriptPath);
+            return 2;
+        }
+        bool ok = loadScript(f, hasEnd, endMs);
+        if ( f != stdin ) fclose(f);
+        if ( !ok ) return 2;
+    }
+    if ( !hasDuration ) {
+        durationMs = endMs;
+        if ( !hasEnd ) {
+            for (const ScriptEvent& e : events) {
+                if ( e.atMs > durationMs ) durationMs = e.atMs;
+            }
+            durationMs += 1000;
+        }
+    }
+
+    HostArduino::setMillis(startMs);
+    for (ScriptEvent& e : events) {
+        HostArduino::schedule(startMs + e.atMs, &apply, &e, 0);
+    }
+
+    HostArduino::schedule(startMs + durationMs, &finish, nullptr, 0);
+
+    setup();
+    while ( true ) {
+        loop();
+        HostArduino::advanceMicros(stepUs);
+    }
+}
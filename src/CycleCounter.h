@@ -0,0 +1,71 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_CYCLE_COUNTER_H
+#define INPUT_EVENTS_CYCLE_COUNTER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief A thin wrapper around the CPU cycle counter, where the board has one.
+ *
+ * @details Used by InputManager (and the Benchmark example) to measure the cost of an update() pass.
+ *
+ * Cycle counters are used on ESP32, ESP8266, RP2040 and Teensy (3.x & 4.x). All other boards fall back
+ * to micros(), in which case isMicros() will return true. The host build (extras/host) uses the host CPU's
+ * counter because its micros() is a virtual clock.
+ *
+ */
+class CycleCounter {
+
+public:
+
+    /**
+     * @brief Enable the cycle counter if the board requires it (Idempotent).
+     */
+    static void begin() {
+        #if defined(ARM_DWT_CYCCNT) && defined(ARM_DEMCR)
+        // Teensy 3.x does not enable the DWT cycle counter by default
+        ARM_DEMCR |= ARM_DEMCR_TRCENA;
+        ARM_DWT_CTRL |= ARM_DWT_CTRL_CYCCNTENA;
+        #endif
+    }
+
+    /**
+     * @brief Returns the current cycle count (or micros() if the board does not have a cycle counter).
+     *
+     * @details The counter wraps, so always use the unsigned difference of two reads.
+     */
+    static uint32_t read() {
+        #if defined(ESP32) || defined(ESP8266)
+        return ESP.getCycleCount();
+        #elif defined(ARDUINO_ARCH_RP2040)
+        return rp2040.getCycleCount();
+        #elif defined(ARM_DWT_CYCCNT)
+        return ARM_DWT_CYCCNT;
+        #elif defined(INPUT_EVENTS_HOST)
+        return HostArduino::cycleCount();
+        #else
+        return micros();
+        #endif
+    }
+
+    /**
+     * @brief Returns true if read() is returning micros() rather than CPU cycles.
+     */
+    static constexpr bool isMicros() {
+        #if defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_RP2040) || defined(ARM_DWT_CYCCNT) || defined(INPUT_EVENTS_HOST)
+        return false;
+        #else
+        return true;
+        #endif
+    }
+
+};
+
+#endif
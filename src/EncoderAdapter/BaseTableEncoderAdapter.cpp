@@ -2,3 +2,26 @@
 
 // Quadrature lookup table
 constexpr int8_t BaseTableEncoderAdapter::table[16];
+
+void BaseTableEncoderAdapter::countEdges(uint8_t changed) {
+    uint32_t now = InputEventsClock::now();
+    if ( windowEdges == 0 ) {
+        windowStartMs = now;
+    } else {
+        uint32_t elapsed = now - windowStartMs;
+        if ( elapsed >= EDGE_WINDOW_MS ) {
+            // Closed by the first edge after the window, so a pause in turning lowers the rate rather than raising it
+            uint32_t rate = (uint32_t)windowEdges * 1000 / elapsed;
+            lastEdgeRate = rate > 0xFFFF ? 0xFFFF : (uint16_t)rate;
+            if ( lastEdgeRate > peakRate ) peakRate = lastEdgeRate;
+            windowEdges = 0;
+            windowStartMs = now;
+        }
+    }
+    if ( changed == 3 ) {
+        illegal++;
+        windowEdges += 2;
+    } else {
+        windowEdges++;
+    }
+}
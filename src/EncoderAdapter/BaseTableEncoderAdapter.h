@@ -3,10 +3,15 @@
 
 #include "IEncoderAdapter.h"
 #include <Arduino.h>
+#include "InputEventsClock.h"
 
 /**
  * @brief A base class for encoder adapters that uses a quadrature encoder table to determine posion changes from pins.
  * 
+ * @details If both pins have changed since the last update(), a state was missed - the encoder is turning faster than
+ * it is polled - and the direction (so the step) is lost. These illegal transitions are counted, along with the rate of
+ * edges seen by update(), so poll rates and loop budgets can be tuned in the field: if illegalTransitions() is rising,
+ * poll at least suggestedPollRate() times a second.
  */
 class BaseTableEncoderAdapter : public IEncoderAdapter {
 public:
@@ -32,9 +37,47 @@ public:
      */
     virtual void update() {
         uint8_t state = (readPin(_pinA) << 1) | readPin(_pinB);
-        uint8_t idx = (_prevState << 2) | state;
-        _position += table[idx];
-        _prevState = state;
+        uint8_t changed = _prevState ^ state;
+        if ( changed ) {
+            countEdges(changed);
+            uint8_t idx = (_prevState << 2) | state;
+            _position += table[idx];
+            _prevState = state;
+        }
+    }
+
+    /**
+     * @brief The number of times both pins changed between two update()s (table indices 3, 6, 9 and 12) since
+     * resetStats(). Each is at least one lost step.
+     */
+    uint32_t illegalTransitions() { return illegal; }
+
+    /**
+     * @brief The edges per second seen by update() over the last measured window (about EDGE_WINDOW_MS).
+     * 
+     * @details An illegal transition counts as two edges, so this under-reports once steps are being lost.
+     */
+    uint16_t edgeRate() { return lastEdgeRate; }
+
+    /**
+     * @brief The highest edgeRate() since resetStats().
+     */
+    uint16_t peakEdgeRate() { return peakRate; }
+
+    /**
+     * @brief The minimum number of update()s per second to see every state at peakEdgeRate(): two per edge, leaving a
+     * margin for the jitter in the loop.
+     */
+    uint32_t suggestedPollRate() { return (uint32_t)peakRate * 2; }
+
+    /**
+     * @brief Reset illegalTransitions(), edgeRate() and peakEdgeRate().
+     */
+    void resetStats() {
+        illegal = 0;
+        windowEdges = 0;
+        lastEdgeRate = 0;
+        peakRate = 0;
     }
 
     virtual ~BaseTableEncoderAdapter() {}
@@ -57,11 +100,27 @@ protected:
         0, -1, 1, 0
     };
 
+    static constexpr uint16_t EDGE_WINDOW_MS = 100; ///< The minimum window over which edgeRate() is measured
+
+    /**
+     * @brief Count the edges of a change of state and close the edge rate window if it has passed.
+     * 
+     * @param changed The pins that changed (bit 1 A, bit 0 B)
+     */
+    void countEdges(uint8_t changed);
+
     uint8_t _pinA, _pinB;
     uint8_t _prevState = 0;
     int32_t _position = 0;
     bool _externalUpdate = false; ///< Some implementations may allow the update via an interupt.
 
+private:
+    uint32_t illegal = 0;
+    uint32_t windowStartMs = 0;
+    uint16_t windowEdges = 0;
+    uint16_t lastEdgeRate = 0;
+    uint16_t peakRate = 0;
+
 };
 
 
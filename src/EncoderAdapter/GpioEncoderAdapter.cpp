@@ -0,0 +1,109 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "GpioEncoderAdapter.h"
+
+GpioEncoderAdapter* GpioEncoderAdapter::encoders[MAX_ENCODERS] = {};
+
+void INPUT_EVENTS_ISR_ATTR GpioEncoderAdapter::onInterrupt0() { encoders[0]->onInterrupt(); }
+void INPUT_EVENTS_ISR_ATTR GpioEncoderAdapter::onInterrupt1() { encoders[1]->onInterrupt(); }
+void INPUT_EVENTS_ISR_ATTR GpioEncoderAdapter::onInterrupt2() { encoders[2]->onInterrupt(); }
+void INPUT_EVENTS_ISR_ATTR GpioEncoderAdapter::onInterrupt3() { encoders[3]->onInterrupt(); }
+
+void INPUT_EVENTS_ISR_ATTR GpioEncoderAdapter::onInterrupt() {
+    // Not readPin() - a virtual call may not be in IRAM
+    #ifdef INPUT_EVENTS_GPIO_ENCODER_PORT_IO
+    uint8_t state = ((*inA & maskA) ? 2 : 0) | ((*inB & maskB) ? 1 : 0);
+    #else
+    uint8_t state = (digitalRead(_pinA) == HIGH ? 2 : 0) | (digitalRead(_pinB) == HIGH ? 1 : 0);
+    #endif
+    isrPosition += table[(_prevState << 2) | state];
+    _prevState = state;
+}
+
+bool GpioEncoderAdapter::begin() {
+    detach();
+    pinMode(_pinA, mode);
+    pinMode(_pinB, mode);
+    #ifdef INPUT_EVENTS_GPIO_ENCODER_PORT_IO
+    inA = portInputRegister(digitalPinToPort(_pinA));
+    maskA = digitalPinToBitMask(_pinA);
+    inB = portInputRegister(digitalPinToPort(_pinB));
+    maskB = digitalPinToBitMask(_pinB);
+    #endif
+    _prevState = (readPin(_pinA) << 1) | readPin(_pinB);
+    _externalUpdate = false;
+
+    int irqA = digitalPinToInterrupt(_pinA);
+    int irqB = digitalPinToInterrupt(_pinB);
+    #ifdef NOT_AN_INTERRUPT
+    if ( irqA == NOT_AN_INTERRUPT || irqB == NOT_AN_INTERRUPT ) return false;
+    #endif
+    uint8_t free = 0;
+    while ( free < MAX_ENCODERS && encoders[free] ) {
+        free++;
+    }
+    if ( free == MAX_ENCODERS ) return false;
+    static void (* const isrs[MAX_ENCODERS])() = { onInterrupt0, onInterrupt1, onInterrupt2, onInterrupt3 };
+    isrPosition = _position;
+    encoders[free] = this;
+    slot = free;
+    _externalUpdate = true;
+    attachInterrupt(irqA, isrs[slot], CHANGE);
+    attachInterrupt(irqB, isrs[slot], CHANGE);
+    return true;
+}
+
+int32_t GpioEncoderAdapter::getPosition() {
+    if ( !isInterruptDriven() ) return BaseTableEncoderAdapter::getPosition();
+    #if defined(__AVR__)
+    uint8_t sreg = SREG; // Restore rather than enable, in case interrupts were already off
+    cli();
+    int32_t pos = isrPosition;
+    SREG = sreg;
+    return pos;
+    #elif __SIZEOF_POINTER__ < 4
+    noInterrupts();
+    int32_t pos = isrPosition;
+    interrupts();
+    return pos;
+    #else
+    return isrPosition; // An aligned 32 bit read is a single load on 32 bit MCUs so cannot be torn
+    #endif
+}
+
+void GpioEncoderAdapter::setPosition(int32_t pos) {
+    _position = pos;
+    if ( !isInterruptDriven() ) return;
+    #if defined(__AVR__)
+    uint8_t sreg = SREG;
+    cli();
+    isrPosition = pos;
+    SREG = sreg;
+    #elif __SIZEOF_POINTER__ < 4
+    noInterrupts();
+    isrPosition = pos;
+    interrupts();
+    #else
+    isrPosition = pos;
+    #endif
+}
+
+void GpioEncoderAdapter::detach() {
+    if ( !isInterruptDriven() ) return;
+    detachInterrupt(digitalPinToInterrupt(_pinA));
+    detachInterrupt(digitalPinToInterrupt(_pinB));
+    _position = isrPosition; // Carry on from here if polled
+    encoders[slot] = nullptr;
+    slot = NO_SLOT;
+    _externalUpdate = false;
+}
+
+GpioEncoderAdapter::~GpioEncoderAdapter() {
+    detach();
+}
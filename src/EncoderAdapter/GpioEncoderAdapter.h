@@ -0,0 +1,135 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_GPIO_ENCODER_ADAPTER_H
+#define INPUT_EVENTS_GPIO_ENCODER_ADAPTER_H
+
+#include "BaseTableEncoderAdapter.h"
+
+#if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+    #define INPUT_EVENTS_GPIO_ENCODER_PORT_IO
+#endif
+
+// The ESP8266 and ESP32 cores require ISRs to be in IRAM
+#ifdef IRAM_ATTR
+    #define INPUT_EVENTS_ISR_ATTR IRAM_ATTR
+#else
+    #define INPUT_EVENTS_ISR_ATTR
+#endif
+
+/**
+ * @brief An encoder adapter for an encoder on two MCU pins, decoded in pin change interrupts. No encoder library is
+ * needed.
+ *
+ * @details begin() attaches a CHANGE interrupt to both phases and the ISR runs the quadrature table, so no step is lost
+ * however slow the loop() is. The ISR reads the pins through their port registers (where the core provides
+ * portInputRegister()) to keep it short - a 600 PPR encoder at 5 rev/s is 12,000 interrupts a second.
+ *
+ * The position is a 32 bit counter written by the ISR. On 8 bit MCUs (eg AVR) reading it takes four instructions, so
+ * getPosition() and setPosition() hold off interrupts while they copy it (restoring the previous interrupt state)
+ * rather than risk a torn value if an edge arrives mid-read.
+ *
+ * Both pins should support interrupts (see <code>digitalPinToInterrupt()</code>). If they do not, or MAX_ENCODERS are
+ * already attached, begin() returns false and the encoder is decoded each time getPosition() is called instead, like
+ * ExpanderEncoderAdapter. The illegal transition and edge rate statistics (see BaseTableEncoderAdapter) are only kept
+ * when polled - the ISR is kept as short as possible.
+ * ```
+ * GpioEncoderAdapter encoderAdapter(2, 3);
+ * EventEncoder myEncoder(&encoderAdapter);
+ * ```
+ */
+class GpioEncoderAdapter : public BaseTableEncoderAdapter {
+
+public:
+
+    static constexpr uint8_t MAX_ENCODERS = 4; ///< The number of encoders that can be decoded in interrupts
+
+    /**
+     * @brief Construct a GpioEncoderAdapter
+     *
+     * @param encoderPinA The MCU pin for the encoder A pin
+     * @param encoderPinB The MCU pin for the encoder B pin
+     * @param pinMode The mode of both pins. Default is INPUT_PULLUP.
+     */
+    GpioEncoderAdapter(uint8_t encoderPinA, uint8_t encoderPinB, uint8_t pinMode = INPUT_PULLUP)
+        : mode(pinMode)
+        {
+            _pinA = encoderPinA;
+            _pinB = encoderPinB;
+        }
+
+    /**
+     * @brief Set the pin modes and attach the interrupts.
+     *
+     * @return true The encoder is decoded in interrupts
+     * @return false The encoder is decoded when getPosition() is called (a pin has no interrupt or MAX_ENCODERS are
+     * already attached)
+     */
+    bool begin() override;
+
+    /**
+     * @brief Get the current position of the encoder. Safe against a torn read on 8 bit MCUs.
+     */
+    int32_t getPosition() override;
+
+    /**
+     * @brief Set the position of the encoder.
+     */
+    void setPosition(int32_t pos) override;
+
+    /**
+     * @brief Returns true if the encoder is decoded in interrupts.
+     */
+    bool isInterruptDriven() { return slot != NO_SLOT; }
+
+    /**
+     * @brief Detach the interrupts.
+     */
+    ~GpioEncoderAdapter();
+
+protected:
+
+    uint8_t readPin(uint8_t pin) const override {
+        #ifdef INPUT_EVENTS_GPIO_ENCODER_PORT_IO
+        if ( pin == _pinA ) return (*inA & maskA) != 0;
+        return (*inB & maskB) != 0;
+        #else
+        return digitalRead(pin) == HIGH;
+        #endif
+    }
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static GpioEncoderAdapter* encoders[MAX_ENCODERS];
+    static void onInterrupt0();
+    static void onInterrupt1();
+    static void onInterrupt2();
+    static void onInterrupt3();
+
+    /**
+     * @brief The ISR: read both pins and apply the quadrature table.
+     */
+    void onInterrupt();
+
+    void detach();
+
+    volatile int32_t isrPosition = 0; ///< Written by the ISR, see getPosition()
+    uint8_t slot = NO_SLOT;
+    uint8_t mode;
+
+    #ifdef INPUT_EVENTS_GPIO_ENCODER_PORT_IO
+    typedef decltype(portInputRegister(digitalPinToPort(0))) InputRegister;
+    typedef decltype(digitalPinToBitMask(0)) PortMask;
+    InputRegister inA = nullptr;
+    InputRegister inB = nullptr;
+    PortMask maskA = 0;
+    PortMask maskB = 0;
+    #endif
+};
+
+#endif
@@ -83,7 +83,7 @@ public:
 private:
 
 
-    Encoder *encoder;
+    Encoder *encoder = nullptr;
 
     uint8_t pinA;
     uint8_t pinB;
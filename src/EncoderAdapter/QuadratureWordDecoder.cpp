@@ -0,0 +1,57 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "QuadratureWordDecoder.h"
+
+QuadratureWordDecoder::QuadratureWordDecoder(int32_t* positions, uint8_t encoderCount)
+    : positions(positions),
+      encoders(encoderCount < 1 ? 1 : (encoderCount > MAX_ENCODERS ? MAX_ENCODERS : encoderCount))
+    {
+        laneMask = 0x55555555UL >> (2 * (MAX_ENCODERS - encoders));
+    }
+
+void QuadratureWordDecoder::begin(uint32_t word) {
+    previous = word;
+    forward = backward = errors = 0;
+    errorTotal = 0;
+}
+
+uint16_t QuadratureWordDecoder::update(uint32_t word) {
+    // Line up each encoder's previous and new A and B on its A bit
+    uint32_t a0 = previous & laneMask;
+    uint32_t b0 = (previous >> 1) & laneMask;
+    uint32_t a1 = word & laneMask;
+    uint32_t b1 = (word >> 1) & laneMask;
+    previous = word;
+    uint32_t changedA = a0 ^ a1;
+    uint32_t changedB = b0 ^ b1;
+    uint32_t valid = changedA ^ changedB; // Exactly one of A and B changed
+    uint32_t fwd = valid & (a0 ^ b1);
+    forward = compact(fwd);
+    backward = compact(valid ^ fwd);
+    errors = compact(changedA & changedB);
+    uint16_t moved = forward | backward;
+    if ( !(moved | errors) ) return 0;
+    for (uint16_t m = errors; m; m &= m - 1) {
+        errorTotal++;
+    }
+    for (uint16_t m = moved; m; m &= m - 1) {
+        uint8_t e = __builtin_ctz(m);
+        positions[e] += ((forward >> e) & 1) ? 1 : -1;
+    }
+    return moved;
+}
+
+uint16_t QuadratureWordDecoder::compact(uint32_t lanes) {
+    // Gather the even bits into the low 16 bits
+    lanes = (lanes | (lanes >> 1)) & 0x33333333UL;
+    lanes = (lanes | (lanes >> 2)) & 0x0F0F0F0FUL;
+    lanes = (lanes | (lanes >> 4)) & 0x00FF00FFUL;
+    lanes = (lanes | (lanes >> 8)) & 0x0000FFFFUL;
+    return (uint16_t)lanes;
+}
@@ -0,0 +1,151 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_QUADRATURE_WORD_DECODER_H
+#define INPUT_EVENTS_QUADRATURE_WORD_DECODER_H
+
+#include <Arduino.h>
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+
+/**
+ * @brief Decodes up to 16 quadrature encoders from one word of pin states (an expander's readAll() or a port register)
+ * in a single pass.
+ *
+ * @details Encoder i is on bits 2i (pin A) and 2i + 1 (pin B) of the word. Rather than reading two pins and looking up
+ * the quadrature table for each encoder, update() compares the whole word with the previous one using a handful of
+ * bitwise operations, so its cost does not depend on the number of encoders. Only the encoders that moved have their
+ * positions updated.
+ *
+ * For each encoder, a step is valid if exactly one of A and B changed and it is forward (+1, matching
+ * BaseTableEncoderAdapter) if the previous A differs from the new B. If both changed, a step was missed (the encoder
+ * is turning faster than update() is called) - it is counted by errorCount() and ignored.
+ *
+ * Use WordEncoderAdapter to connect an EventEncoder to one of the encoders and FixedQuadratureWordDecoder to create a
+ * decoder with its own storage.
+ * ```
+ * AdafruitMCP23017ExpanderAdapter mcp;
+ * FixedQuadratureWordDecoder<8> decoder;
+ * EventEncoder encoder0(new WordEncoderAdapter(decoder, 0));
+ *
+ * void setup() {
+ *     mcp.begin();
+ *     for (byte pin = 0; pin < 16; pin++) {
+ *         mcp.attachPin(pin);
+ *     }
+ *     mcp.update();
+ *     decoder.begin(mcp); // Start from the current pin states
+ *     encoder0.begin();
+ * }
+ *
+ * void loop() {
+ *     mcp.update();
+ *     decoder.update(mcp);
+ *     encoder0.update();
+ * }
+ * ```
+ */
+class QuadratureWordDecoder {
+
+public:
+
+    static constexpr uint8_t MAX_ENCODERS = 16;
+
+    /**
+     * @brief Construct a QuadratureWordDecoder using external storage.
+     *
+     * @param positions An array of at least encoderCount positions
+     * @param encoderCount The number of encoders (1-16)
+     */
+    QuadratureWordDecoder(int32_t* positions, uint8_t encoderCount);
+
+    /**
+     * @brief Set the initial pin states. Call before the first update(), otherwise the first update() compares the
+     * pins with all LOW and can step (or count errors for) every encoder whose pins are HIGH.
+     */
+    void begin(uint32_t word);
+
+    /**
+     * @brief Set the initial pin states from an expander.
+     *
+     * @param firstPin The expander pin of encoder 0 pin A
+     */
+    void begin(GpioExpanderAdapter& expander, uint8_t firstPin = 0) { begin(expander.readAll() >> firstPin); }
+
+    /**
+     * @brief Decode all of the encoders from a new word of pin states.
+     *
+     * @return uint16_t The encoders that moved, one bit per encoder
+     */
+    uint16_t update(uint32_t word);
+
+    /**
+     * @brief Decode all of the encoders from an expander's pins. The expander must have been updated.
+     *
+     * @param firstPin The expander pin of encoder 0 pin A
+     */
+    uint16_t update(GpioExpanderAdapter& expander, uint8_t firstPin = 0) { return update(expander.readAll() >> firstPin); }
+
+    /**
+     * @brief The step of an encoder on the last update(): -1, 0 or +1.
+     */
+    int8_t delta(uint8_t encoder) const {
+        return (int8_t)((forward >> encoder) & 1) - (int8_t)((backward >> encoder) & 1);
+    }
+
+    /**
+     * @brief The encoders that moved forward on the last update(), one bit per encoder.
+     */
+    uint16_t forwardMask() const { return forward; }
+
+    /**
+     * @brief The encoders that moved backward on the last update(), one bit per encoder.
+     */
+    uint16_t backwardMask() const { return backward; }
+
+    /**
+     * @brief The encoders whose A and B both changed on the last update() (a missed step), one bit per encoder.
+     */
+    uint16_t errorMask() const { return errors; }
+
+    /**
+     * @brief The number of missed steps (of all encoders) since begin().
+     */
+    uint32_t errorCount() const { return errorTotal; }
+
+    int32_t getPosition(uint8_t encoder) const { return encoder < encoders ? positions[encoder] : 0; }
+
+    void setPosition(uint8_t encoder, int32_t pos) { if ( encoder < encoders ) positions[encoder] = pos; }
+
+    uint8_t encoderCount() const { return encoders; }
+
+private:
+    int32_t* positions;
+    uint8_t encoders;
+    uint32_t laneMask; ///< The A bit of each encoder
+    uint32_t previous = 0;
+    uint16_t forward = 0;
+    uint16_t backward = 0;
+    uint16_t errors = 0;
+    uint32_t errorTotal = 0;
+
+    static uint16_t compact(uint32_t lanes);
+};
+
+/**
+ * @brief A QuadratureWordDecoder with its own storage for ENCODERS (1-16) encoders.
+ */
+template <uint8_t ENCODERS>
+class FixedQuadratureWordDecoder : public QuadratureWordDecoder {
+    static_assert(ENCODERS > 0 && ENCODERS <= QuadratureWordDecoder::MAX_ENCODERS, "ENCODERS must be 1-16");
+public:
+    FixedQuadratureWordDecoder() : QuadratureWordDecoder(storage, ENCODERS) {}
+private:
+    int32_t storage[ENCODERS] = {};
+};
+
+#endif
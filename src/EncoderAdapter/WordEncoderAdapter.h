@@ -0,0 +1,46 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_WORD_ENCODER_ADAPTER_H
+#define INPUT_EVENTS_WORD_ENCODER_ADAPTER_H
+
+#include "IEncoderAdapter.h"
+#include "QuadratureWordDecoder.h"
+
+/**
+ * @brief An encoder adapter for one of the encoders of a QuadratureWordDecoder.
+ *
+ * @details The decoder's update() must be called (once for all of its encoders) before the EventEncoder's update().
+ */
+class WordEncoderAdapter : public IEncoderAdapter {
+
+public:
+
+    /**
+     * @brief Construct a WordEncoderAdapter
+     *
+     * @param decoder The decoder
+     * @param encoder The index of the encoder in the decoder's word (pins 2 * encoder and 2 * encoder + 1)
+     */
+    WordEncoderAdapter(QuadratureWordDecoder& decoder, uint8_t encoder)
+        : decoder(&decoder),
+          encoder(encoder)
+        {}
+
+    bool begin() override { return encoder < decoder->encoderCount(); }
+
+    int32_t getPosition() override { return decoder->getPosition(encoder); }
+
+    void setPosition(int32_t pos) override { decoder->setPosition(encoder, pos); }
+
+private:
+    QuadratureWordDecoder* decoder;
+    uint8_t encoder;
+};
+
+#endif
@@ -33,9 +33,18 @@ void EventAnalog::unsetCallback() {
 }
 
 void EventAnalog::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventAnalog::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventAnalog::eventPayload(InputEventType et) {
+    if ( et == InputEventType::CHANGED ) return position();
+    return 0;
 }
 
 void EventAnalog::update() {
@@ -61,7 +70,8 @@ void EventAnalog::update() {
             }
         }
         if ( _enabled ) {
-            if( millis() > (rateLimitCounter + rateLimit) ) { 
+            uint32_t now = InputEventsClock::now();
+            if ( now - rateLimitCounter > rateLimit ) { // Safe across millis() rollover
                 setReadPos(readVal - startVal);
                 if ( currentPos != readPos ) {
                     previousPos = currentPos;
@@ -69,7 +79,7 @@ void EventAnalog::update() {
                     _hasChanged = true;
                     invoke(InputEventType::CHANGED);
                 }
-                rateLimitCounter = millis();
+                rateLimitCounter = now;
             }
             EventInputBase::update();
         }
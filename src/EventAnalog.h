@@ -31,17 +31,10 @@ class EventAnalog : public EventInputBase {
 
 protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventAnalog &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventAnalog &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventAnalog &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
@@ -54,6 +47,12 @@ protected:
      * @param et Enum of type <code>InputEventType</code>
      */
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The position for CHANGED.
+     */
+    int32_t eventPayload(InputEventType et) override;
 
 public:
 
@@ -97,22 +96,15 @@ public:
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventAnalog::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventAnalog&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventAnalog &ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -123,7 +115,7 @@ public:
     /**
      * @brief Update the state from the analog input. Must be called from within <code>loop()</code> in order to update state from the pin.
      */
-    void update();
+    void update() override;
     /*@}*/
 
     ///@{
@@ -333,7 +325,7 @@ private:
     bool _started = false;
 
     uint16_t rateLimit = 0;
-    unsigned long rateLimitCounter = 0;   
+    uint32_t rateLimitCounter = 0;
 
     void setReadPos(int16_t offset);
     void setInitialReadPos();
@@ -48,6 +48,7 @@ void EventButton::unsetCallback() {
 
 void EventButton::update() {
     if (_enabled) {
+        InputEventsClock::Snapshot now; // All durations in this update use the same time
         //button update (fires pressed/released callbacks)
         if ( changedState() ) {
             if (pressing()) {
@@ -63,8 +64,8 @@ void EventButton::update() {
         //fire long press callbacks
         if (currentState == pressedState) {
             resetIdleTimer();
-            if (currentDuration() > (uint16_t)(longClickDuration + (longPressCounter * longPressInterval ))) {
-                longPressCounter++;
+            if (currentDuration() > longPressThreshold) {
+                setLongPressCounter(longPressCounter + 1);
                 if ((repeatLongPress || longPressCounter == 1) ) {
                     invoke(InputEventType::LONG_PRESS);
                 }
@@ -77,7 +78,7 @@ void EventButton::update() {
                 clickCounter = 0;
                 prevClickCount = 1;
                 invoke(InputEventType::LONG_CLICKED);
-                longPressCounter = 0;
+                setLongPressCounter(0);
             } else {
                 if ( clickCounter == 1 ) {
                     invoke(InputEventType::CLICKED);
@@ -94,16 +95,59 @@ void EventButton::update() {
 }
 
 
+bool EventButton::nextDeadline(uint32_t& deadlineMs) {
+    bool found = EventInputBase::nextDeadline(deadlineMs);
+    if ( !_enabled ) return found;
+    uint32_t ms;
+    if ( debouncer && debouncer->nextDeadline(ms) ) {
+        mergeDeadline(found, deadlineMs, ms);
+    }
+    if ( currentState == pressedState ) {
+        mergeDeadline(found, deadlineMs, stateChangeLastTime + longPressThreshold + 1);
+    } else if ( !clickFired ) {
+        mergeDeadline(found, deadlineMs, stateChangeLastTime + multiClickInterval + 1);
+    }
+    return found;
+}
+
+bool EventButton::hasInputChanged() {
+    return pinAdapter->read() != currentPinState;
+}
+
+bool EventButton::attachWakeSource(SleepAdapter& sleepAdapter) {
+    return pinAdapter->attachWakeSource(sleepAdapter);
+}
+
 void EventButton::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventButton::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventButton::eventPayload(InputEventType et) {
+    switch (et) {
+    case InputEventType::CLICKED :
+    case InputEventType::DOUBLE_CLICKED :
+    case InputEventType::MULTI_CLICKED :
+        return clickCount();
+    case InputEventType::LONG_PRESS :
+        return longPressCount();
+    case InputEventType::RELEASED :
+    case InputEventType::LONG_CLICKED :
+        return previousDuration();
+    default:
+        return 0;
+    }
 }
 
 void EventButton::onDisabled() {
     //Reset button state
     clickCounter = 0;
-    longPressCounter = 0;
+    setLongPressCounter(0);
     invoke(InputEventType::DISABLED);
 }
 
@@ -130,8 +174,9 @@ void EventButton::changeState(bool newState) {
     previousState = currentState;
     currentState = newState;
     stateChanged = true;
-    durationOfPreviousState = millis() - stateChangeLastTime;
-    stateChangeLastTime = millis();
+    uint32_t now = InputEventsClock::now();
+    durationOfPreviousState = now - stateChangeLastTime;
+    stateChangeLastTime = now;
 }
 
 void EventButton::setDebouncer(DebounceAdapter* debounceAdapter) {
@@ -150,4 +195,4 @@ bool EventButton::setDebounceInterval(uint16_t intervalMs) {
     return false;
 }
 
-uint32_t EventButton::currentDuration() { return (millis() - stateChangeLastTime); }
+uint32_t EventButton::currentDuration() { return (InputEventsClock::now() - stateChangeLastTime); }
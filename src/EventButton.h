@@ -36,17 +36,10 @@ class EventButton : public EventInputBase {
 
     protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventButton &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventButton &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventButton &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
@@ -113,22 +106,14 @@ class EventButton : public EventInputBase {
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventButton::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventButton&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventButton& ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -142,7 +127,22 @@ class EventButton : public EventInputBase {
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update() override;
+
+    /**
+     * @brief Adds debounce settle, LONG_PRESS (and repeat) and multi click expiry to the IDLE deadline.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+
+    /**
+     * @brief Returns true if the pin state differs from the current (debounced) state.
+     */
+    bool hasInputChanged() override;
+
+    /**
+     * @brief Arms the button pin as a wake source.
+     */
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override;
 
     ///@}
 
@@ -208,7 +208,7 @@ class EventButton : public EventInputBase {
      * 
      * @param longDurationMs Default 750ms
      */
-    void setLongClickDuration(uint16_t longDurationMs=750) { longClickDuration = longDurationMs; }
+    void setLongClickDuration(uint16_t longDurationMs=750) { longClickDuration = longDurationMs; setLongPressCounter(longPressCounter); }
 
     /**
      * @brief Set the number of milliseconds that define the *subbsequent* long click intervals.
@@ -216,7 +216,7 @@ class EventButton : public EventInputBase {
     * 
      * @param intervalMs The interval in milliseconds (default is 500ms).
      */
-    void setLongPressInterval(uint16_t intervalMs=500) { longPressInterval = intervalMs; }
+    void setLongPressInterval(uint16_t intervalMs=500) { longPressInterval = intervalMs; setLongPressCounter(longPressCounter); }
 
     /**
      * @brief Set the multi click interval.
@@ -263,6 +263,12 @@ class EventButton : public EventInputBase {
      * @param et Enum of type <code>InputEventType</code>
      */
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The click count, long press count or previous (pressed) duration.
+     */
+    int32_t eventPayload(InputEventType et) override;
 
 
     /**
@@ -310,10 +316,18 @@ class EventButton : public EventInputBase {
      */
     bool pressing() { return stateChanged && previousState != pressedState; }
 
+    /**
+     * @brief Set the long press counter and the duration at which the next LONG_PRESS will fire
+     */
+    void setLongPressCounter(uint16_t count) {
+        longPressCounter = count;
+        longPressThreshold = (uint16_t)(longClickDuration + (longPressCounter * longPressInterval ));
+    }
+
     private:
 
     PinAdapter* pinAdapter;
-    DebounceAdapter* debouncer;
+    DebounceAdapter* debouncer = nullptr;
 
     bool pressedState = LOW; //The state that represents 'pressed'
 
@@ -338,6 +352,7 @@ class EventButton : public EventInputBase {
     bool repeatLongPress = true;
     uint16_t longPressInterval = 500;
     uint16_t longPressCounter = 0;
+    uint16_t longPressThreshold = 750; //The currentDuration() at which the next LONG_PRESS fires
 
 
 
@@ -8,9 +8,7 @@
 
 #include "EventEncoder.h"
 
-#ifdef FUNCTIONAL_SUPPORTED
-    #include <functional>
-#endif
+constexpr EventEncoder::AccelerationStep EventEncoder::DEFAULT_ACCELERATION[];
 
 /**
  * Construct a rotary encoder
@@ -20,7 +18,7 @@ EventEncoder::EventEncoder(IEncoderAdapter *encoderAdapter) {
 }
 
 EventEncoder::~EventEncoder() {
-    delete encoder;
+    // The encoder adapter is owned by the sketch
 }
 
 void EventEncoder::begin() {
@@ -28,17 +26,27 @@ void EventEncoder::begin() {
 }
 
 void EventEncoder::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventEncoder::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventEncoder::eventPayload(InputEventType et) {
+    if ( et == InputEventType::CHANGED ) return increment();
+    return 0;
 }
 
 
 void EventEncoder::onEnabled() {
-    //Reset the encoder so we don't trigger other events
-    //idleFlagged = true;
-    //encoder->write(encoderPosition*positionDivider);
-    encoder->setPosition(currentPosition*positionDivider);
+    //Carry on from where the adapter is now, so turns while disabled don't trigger events. The adapter is not set from
+    //currentPosition, which no longer tracks the adapter once acceleration or resetPosition() has been used.
+    lastRawPosition = encoder->getPosition();
+    oldPosition = dividePosition(lastRawPosition);
+    resetVelocity();
     invoke(InputEventType::ENABLED);
 }
 
@@ -51,21 +59,118 @@ void EventEncoder::update() {
     // @TODO Do we store the current position when disabled and update if re-enabled?
     if ( _enabled ) {
         //encoder udate (fires encoder rotation callbacks)
-        if ( (millis() - rateLimitCounter) >= rateLimit ) { 
+        uint32_t now = InputEventsClock::now();
+        if ( (now - rateLimitCounter) >= rateLimit ) { 
                 readIncrement();
+            rawEncoderIncrement = encoderIncrement;
+            updateVelocity(encoderIncrement);
             if ( encoderIncrement !=0 ) {
+                if ( acceleration ) encoderIncrement = accelerate(encoderIncrement);
                 currentPosition += encoderIncrement;
                 invoke(InputEventType::CHANGED);
+                rateLimitCounter = now; // Only a CHANGED starts the limit, so it does not depend on how often update() is called
             }
-            rateLimitCounter = millis();
         }
         EventInputBase::update();
     }
 }
 
+bool EventEncoder::nextDeadline(uint32_t& deadlineMs) {
+    bool found = EventInputBase::nextDeadline(deadlineMs);
+    if ( _enabled && rateLimit > 0 && dividedPosition() != oldPosition ) {
+        mergeDeadline(found, deadlineMs, rateLimitCounter + rateLimit);
+    }
+    return found;
+}
+
+bool EventEncoder::hasInputChanged() {
+    return dividedPosition() != oldPosition && (InputEventsClock::now() - rateLimitCounter) >= rateLimit;
+}
+
+void EventEncoder::setPositionDivider(uint8_t divider /*=4*/) {
+    if ( divider > 0 ) {
+        positionDivider = divider;
+        dividerShift = (divider & (divider - 1)) ? NO_SHIFT : __builtin_ctz(divider);
+        oldPosition = dividePosition(lastRawPosition); // So changing the divider does not fire CHANGED
+    }
+}
+
+long EventEncoder::dividedPosition() {
+    int32_t rawPosition = encoder->getPosition();
+    if ( rawPosition == lastRawPosition ) return oldPosition;
+    return dividePosition(rawPosition);
+}
+
+int32_t EventEncoder::dividePosition(int32_t rawPosition) {
+    if ( dividerShift != NO_SHIFT ) {
+        return rawPosition >> dividerShift; // Arithmetic shift, so rounds down for negative positions too
+    }
+    int32_t divided = rawPosition / positionDivider; // Rounds towards zero...
+    if ( rawPosition < 0 && divided * positionDivider != rawPosition ) {
+        divided--; // ...so round negative positions down
+    }
+    return divided;
+}
+
 void EventEncoder::readIncrement() {
-    long newPosition = floor(encoder->getPosition()/positionDivider);
+    int32_t rawPosition = encoder->getPosition();
+    if ( rawPosition == lastRawPosition ) {
+        encoderIncrement = 0; // Not turned - nothing to divide
+        return;
+    }
+    lastRawPosition = rawPosition;
+    int32_t newPosition = dividePosition(rawPosition);
     encoderIncrement = newPosition - oldPosition;
     oldPosition = newPosition;
 }
 
+
+void EventEncoder::setVelocityWindow(uint16_t windowMs /*=200*/) {
+    if ( windowMs < VELOCITY_BUCKETS ) windowMs = VELOCITY_BUCKETS;
+    bucketMs = windowMs / VELOCITY_BUCKETS;
+    velocityScale = (uint16_t)((1000UL << 8) / (bucketMs * VELOCITY_BUCKETS));
+    resetVelocity();
+}
+
+void EventEncoder::resetVelocity() {
+    for (uint8_t i = 0; i < VELOCITY_BUCKETS; i++) {
+        velocityBuckets[i] = 0;
+    }
+    windowSteps = 0;
+    currentVelocity = 0;
+}
+
+void EventEncoder::updateVelocity(int steps) {
+    if ( windowSteps == 0 && steps == 0 ) return; // Stopped - nothing to do
+    uint32_t now = InputEventsClock::now();
+    if ( windowSteps == 0 ) {
+        bucketStartMs = now;
+    }
+    // Move the window on, dropping the oldest quarter each time (at most VELOCITY_BUCKETS times before it is empty)
+    while ( windowSteps > 0 && now - bucketStartMs >= bucketMs ) {
+        bucketStartMs += bucketMs;
+        velocityBucket = (velocityBucket + 1) % VELOCITY_BUCKETS;
+        windowSteps -= velocityBuckets[velocityBucket];
+        velocityBuckets[velocityBucket] = 0;
+    }
+    if ( windowSteps == 0 ) {
+        bucketStartMs = now;
+    }
+    uint16_t magnitude = steps < 0 ? -steps : steps;
+    if ( windowSteps > 0xFFFF - magnitude ) magnitude = 0xFFFF - windowSteps;
+    velocityBuckets[velocityBucket] += magnitude;
+    windowSteps += magnitude;
+    uint32_t v = ((uint32_t)windowSteps * velocityScale) >> 8;
+    currentVelocity = v > 0xFFFF ? 0xFFFF : (uint16_t)v;
+}
+
+int EventEncoder::accelerate(int steps) {
+    uint16_t multiplier = 1;
+    for (uint8_t i = 0; i < accelerationSteps && acceleration[i].minVelocity <= currentVelocity; i++) {
+        multiplier = acceleration[i].multiplier;
+    }
+    int32_t accelerated = (int32_t)steps * multiplier;
+    if ( accelerated > 32767 ) return 32767;
+    if ( accelerated < -32767 ) return -32767;
+    return (int)accelerated;
+}
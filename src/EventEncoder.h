@@ -30,28 +30,31 @@ class EventEncoder : public EventInputBase {
 
     protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventEncoder &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventEncoder &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventEncoder &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
      */
-    CallbackFunction callbackFunction = NULL;
+    CallbackFunction callbackFunction = nullptr;
 
     /**
      * @brief Read and set the increment during update()
      */
     void readIncrement();
 
+    /**
+     * @brief The encoder adapter position divided by the positionDivider
+     */
+    long dividedPosition();
+
+    /**
+     * @brief A raw position divided by the positionDivider, rounded down (towards minus infinity) for negative positions
+     */
+    int32_t dividePosition(int32_t rawPosition);
+
 public:
 
     ///@{ 
@@ -104,23 +107,15 @@ public:
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventButton::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventEncoder&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventEncoder &ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -134,7 +129,17 @@ public:
      * 
      * @details Must be called from within <code>loop()</code>
      */
-    void update();
+    void update() override;
+
+    /**
+     * @brief Adds the end of the rate limit window (if a change is waiting) to the IDLE deadline.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+
+    /**
+     * @brief Returns true if the encoder position has changed and the rate limit allows a CHANGED event.
+     */
+    bool hasInputChanged() override;
     ///@}
 
     ///@{
@@ -152,6 +157,20 @@ public:
      */
     int16_t increment() { return encoderIncrement; }
 
+    /**
+     * @brief The increment before the acceleration curve (see setAcceleration()) was applied.
+     */
+    int16_t rawIncrement() { return rawEncoderIncrement; }
+
+    /**
+     * @brief The speed of the encoder in (divided) steps per second over the velocity window.
+     * 
+     * @details Measured with integer arithmetic only, from the steps read in the last 3-4 quarters of the window
+     * (see setVelocityWindow()). Updated in update(), so it is current in callbacks, and falls to zero once the encoder
+     * has stopped for a window.
+     */
+    uint16_t velocity() { return currentVelocity; }
+
     /**
      * @brief The current position of the encoder. Can be reset with resetPosition()
      */
@@ -169,6 +188,7 @@ public:
      * @details The encoder interupts will sitll be called but this will limit 
      * the call back firing to every set ms - read the 
      * EncoderButton.increment() for lossless counting of encoder.
+     * The first turn after a pause of at least the rate limit fires straight away.
      * Set to zero (default) for no rate limit.
      */
     void setRateLimit(long ms=0) { rateLimit = ms; }
@@ -181,12 +201,9 @@ public:
      * You can set this to any positive integer eg 8 would increment the
      * position every 2 clicks. 
      * Affects pressed+turning for EventEncoderButton too.
+     * A power of two (1, 2, 4, 8...) is divided with a shift, others with an integer division.
      */
-    void setPositionDivider(uint8_t divider=4) {
-        if ( divider > 0 ) {
-                positionDivider = divider;
-            }
-        }
+    void setPositionDivider(uint8_t divider=4);
 
     /**
      * @brief Get the currently set position divider value
@@ -196,6 +213,44 @@ public:
     uint8_t getPositionDivider() { return positionDivider; }
 
 
+    /**
+     * @brief A point on an acceleration curve: from minVelocity (steps per second, see velocity()), each step is
+     * multiplied by multiplier.
+     */
+    struct AccelerationStep {
+        uint16_t minVelocity;
+        uint16_t multiplier;
+    };
+
+    /**
+     * @brief A gentle curve, from x1 below 10 steps per second to x100 above 100 steps per second.
+     */
+    static constexpr AccelerationStep DEFAULT_ACCELERATION[] = { {0, 1}, {10, 2}, {25, 5}, {50, 20}, {100, 100} };
+
+    /**
+     * @brief Multiply increment() (and so position()) by a factor that depends on the velocity(), eg to scroll
+     * through long lists quickly without losing single step precision when turned slowly.
+     * 
+     * @details The curve is a table of AccelerationStep in ascending order of minVelocity. The multiplier of the
+     * last step whose minVelocity is not more than velocity() is used (or 1 below the first step), so the cost is a
+     * short table scan when the encoder moves. The table is not copied.
+     * 
+     * @param curve The curve (default DEFAULT_ACCELERATION) or nullptr to turn acceleration off
+     * @param steps The number of AccelerationSteps in the curve
+     */
+    void setAcceleration(const AccelerationStep* curve = DEFAULT_ACCELERATION,
+                         uint8_t steps = sizeof(DEFAULT_ACCELERATION) / sizeof(AccelerationStep)) {
+        acceleration = curve;
+        accelerationSteps = curve ? steps : 0;
+    }
+
+    /**
+     * @brief Set the time over which velocity() is measured. Default is 200ms.
+     * 
+     * @details Longer windows are smoother, shorter ones react more quickly.
+     */
+    void setVelocityWindow(uint16_t windowMs = 200);
+
     /**
      * @brief Reset the counted position of the encoder. 
      * @details Note: Some underlying encoder libraries may only allow a 'reset' to 0, not the setting of a specific value.
@@ -206,18 +261,44 @@ public:
 protected:
 
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The increment for CHANGED.
+     */
+    int32_t eventPayload(InputEventType et) override;
     void onEnabled() override;
 
 private:
 
     IEncoderAdapter *encoder;
 
+    static constexpr uint8_t NO_SHIFT = 0xFF;
+
     uint8_t positionDivider = 4;
+    uint8_t dividerShift = 2; ///< log2(positionDivider) or NO_SHIFT if it is not a power of two
     int32_t currentPosition  = 0;
     int32_t oldPosition  = 0;
+    int32_t lastRawPosition = 0; ///< The adapter position oldPosition was divided from
     unsigned int rateLimit = 0;
     unsigned long rateLimitCounter = 0;   
     int encoderIncrement  = 0;
+    int rawEncoderIncrement = 0;
+
+    static constexpr uint8_t VELOCITY_BUCKETS = 4;
+    uint16_t velocityBuckets[VELOCITY_BUCKETS] = {}; ///< Steps counted in each quarter of the velocity window
+    uint16_t windowSteps = 0;
+    uint32_t bucketStartMs = 0;
+    uint16_t bucketMs = 50;
+    uint16_t velocityScale = 1280; ///< (1000 << 8) / window, so velocity needs no division
+    uint16_t currentVelocity = 0;
+    uint8_t velocityBucket = 0;
+    const AccelerationStep* acceleration = nullptr;
+    uint8_t accelerationSteps = 0;
+
+    void updateVelocity(int steps);
+    void resetVelocity();
+    int accelerate(int steps);
 
 };
 
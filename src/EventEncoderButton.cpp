@@ -25,15 +25,8 @@ EventEncoderButton::EventEncoderButton(IEncoderAdapter *encoderAdapter, PinAdapt
     }
 
 void EventEncoderButton::setCallbacks() {
-    #ifdef FUNCTIONAL_SUPPORTED
-    encoder.setCallback([&](InputEventType et, EventEncoder &enc) { onInputCallback(et, enc); });
-    button.setCallback([&](InputEventType et, EventButton &btn) { onInputCallback(et, btn); });
-    #else
-    encoder.setOwner(this);
-    encoder.setCallback(EventEncoderButton::encoderCallback);
-    button.setOwner(this);
-    button.setCallback(EventEncoderButton::buttonCallback);
-    #endif
+    encoder.setCallback([this](InputEventType et, EventEncoder &enc) { onInputCallback(et, enc); });
+    button.setCallback([this](InputEventType et, EventButton &btn) { onInputCallback(et, btn); });
 }
 
 void EventEncoderButton::begin() {
@@ -47,14 +40,58 @@ void EventEncoderButton::unsetCallback() {
 }
 
 void EventEncoderButton::update() {
+    InputEventsClock::Snapshot now; // The encoder and button share the same time
     encoder.update();
     button.update();
 }
 
+bool EventEncoderButton::nextDeadline(uint32_t& deadlineMs) {
+    bool found = encoder.nextDeadline(deadlineMs);
+    uint32_t ms;
+    if ( button.nextDeadline(ms) ) {
+        mergeDeadline(found, deadlineMs, ms);
+    }
+    return found;
+}
+
+bool EventEncoderButton::hasInputChanged() {
+    return encoder.hasInputChanged() || button.hasInputChanged();
+}
+
+bool EventEncoderButton::attachWakeSource(SleepAdapter& sleepAdapter) {
+    bool encoderWakes = encoder.attachWakeSource(sleepAdapter);
+    bool buttonWakes = button.attachWakeSource(sleepAdapter);
+    return encoderWakes && buttonWakes;
+}
+
 void EventEncoderButton::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventEncoderButton::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventEncoderButton::eventPayload(InputEventType et) {
+    switch (et) {
+    case InputEventType::CHANGED :
+    case InputEventType::CHANGED_PRESSED :
+        return increment();
+    case InputEventType::CLICKED :
+    case InputEventType::DOUBLE_CLICKED :
+    case InputEventType::MULTI_CLICKED :
+        return clickCount();
+    case InputEventType::LONG_PRESS :
+        return longPressCount();
+    case InputEventType::RELEASED :
+    case InputEventType::CHANGED_RELEASED :
+    case InputEventType::LONG_CLICKED :
+        return previousDuration();
+    default:
+        return 0;
+    }
 }
 
 void EventEncoderButton::onEnabled() {
@@ -46,17 +46,10 @@ class EventEncoderButton : public EventInputBase {
 
     protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventEncoderButton &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventEncoderButton &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventEncoderButton &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
@@ -127,23 +120,15 @@ public:
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventEncoderButton::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventEncoderButton&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventEncoderButton &ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -157,7 +142,22 @@ public:
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update() override;
+
+    /**
+     * @brief Returns the earliest deadline of the encoder and button.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+
+    /**
+     * @brief Returns true if either the encoder or button has changed.
+     */
+    bool hasInputChanged() override;
+
+    /**
+     * @brief Arms the button pin as a wake source. Returns false if the encoder cannot wake the MCU.
+     */
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override;
 
     /**
      * @brief Resets the state of the input: silently enables if disabled, clears any blocked events, sets inputId & inputValue back to 0 and prevents IDLE event firing.
@@ -194,6 +194,11 @@ public:
      */
     int32_t pressedPosition() { return currentPressedPosition; }
 
+    /**
+     * @brief The speed of the encoder in (divided) steps per second. See EventEncoder::velocity()
+     */
+    uint16_t velocity() { return encoder.velocity(); }
+
     /**
      * @brief The number of clicks that have been fired in the MULTI_CLICKED event. 
      * @details This is also set do CLICK and DOUBLE_CLICKED and is reset to zero after any CLICKED event is fired.
@@ -341,6 +346,21 @@ public:
      */
     uint8_t getPositionDivider();
 
+    /**
+     * @brief Multiply increment() by a factor that depends on the velocity(). Affects pressed+turning too.
+     * 
+     * @details See EventEncoder::setAcceleration()
+     */
+    void setAcceleration(const EventEncoder::AccelerationStep* curve = EventEncoder::DEFAULT_ACCELERATION,
+                         uint8_t steps = sizeof(EventEncoder::DEFAULT_ACCELERATION) / sizeof(EventEncoder::AccelerationStep)) {
+        encoder.setAcceleration(curve, steps);
+    }
+
+    /**
+     * @brief Set the time over which velocity() is measured. Default is 200ms.
+     */
+    void setVelocityWindow(uint16_t windowMs = 200) { encoder.setVelocityWindow(windowMs); }
+
 
     /**
      * @brief Reset the counted position of the EventEncoderButton. 
@@ -423,6 +443,12 @@ public:
 
 protected:
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The increment, click count, long press count or previous (pressed) duration.
+     */
+    int32_t eventPayload(InputEventType et) override;
     void onEnabled() override;
     void onDisabled() override;
     void onIdle() override {/* Do nothing. Fire idle callback from either encoder or button but only if both are idle.*/ }
@@ -457,21 +483,6 @@ private:
     void setCallbacks();
     bool onEncoderChanged();
 
-/// \cond DO_NOT_DOCUMENT
-#ifndef FUNCTIONAL_SUPPORTED
-private:
-    static void encoderCallback(InputEventType et, EventEncoder &enc) {
-        EventEncoderButton *instance = static_cast<EventEncoderButton *>(enc.getOwner());
-        if (instance) instance->onInputCallback(et, enc);
-    }
-
-    static void buttonCallback(InputEventType et, EventButton &btn) {
-        EventEncoderButton *instance = static_cast<EventEncoderButton *>(btn.getOwner());
-        if (instance) instance->onInputCallback(et, btn);
-    }
-#endif
-/// \endcond
-
 };
 
 
@@ -10,9 +10,6 @@
 
 void EventInputBase::unsetCallback() {
     callbackIsSet = false;
-    #ifndef FUNCTIONAL_SUPPORTED
-        setOwner(nullptr);
-    #endif
 }
 
 void EventInputBase::update() {
@@ -23,6 +20,21 @@ void EventInputBase::update() {
     }
 }
 
+bool EventInputBase::nextDeadline(uint32_t& deadlineMs) {
+    if ( _enabled && !idleFired ) {
+        deadlineMs = lastEventMs + idleTimeout + 1; // IDLE fires when msSinceLastEvent() > idleTimeout
+        return true;
+    }
+    return false;
+}
+
+void EventInputBase::mergeDeadline(bool& found, uint32_t& deadlineMs, uint32_t candidateMs) {
+    if ( !found || InputEventsClock::isBefore(candidateMs, deadlineMs) ) {
+        deadlineMs = candidateMs;
+    }
+    found = true;
+}
+
 void EventInputBase::onEnabled() { invoke(InputEventType::ENABLED); }
 
 void EventInputBase::onDisabled() { invoke(InputEventType::DISABLED); }
@@ -31,7 +43,7 @@ void EventInputBase::onIdle() { invoke(InputEventType::IDLE); }
 
 
 void EventInputBase::resetIdleTimer() { 
-    lastEventMs = millis(); 
+    lastEventMs = InputEventsClock::now(); 
     idleFired = false;
 }
 
@@ -78,6 +90,13 @@ bool EventInputBase::isInvokable(InputEventType et) {
     return false;
 }
 
+bool EventInputBase::enqueue(InputEventType et) {
+    if ( !eventQueue ) return false;
+    QueuedEvent event = { this, et, InputEventsClock::now(), eventPayload(et) };
+    eventQueue->push(event); //If dropped, it is counted by the queue
+    return true;
+}
+
 void EventInputBase::enable(bool e ) {
     _enabled = e;
     if ( e ) {
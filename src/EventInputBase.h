@@ -12,11 +12,13 @@
 #include <Arduino.h>
 
 #include "InputEvents.h"
+#include "InputEventsClock.h"
+#include "EventQueue.h"
+#include "InlineDelegate.h"
 
-#ifdef FUNCTIONAL_SUPPORTED
-    #include <functional>
-#endif
-
+class InputManager;
+class TimerWheel;
+class SleepAdapter;
 
 /**
  * @brief The common base for InputEvents input classes.
@@ -25,6 +27,9 @@
  */
 class EventInputBase {
 
+    friend class InputManager;
+    friend class TimerWheel;
+    friend class EventQueue;
 
     protected:
 
@@ -32,7 +37,7 @@ class EventInputBase {
     uint8_t input_value = 0; ///< Input value, not used internally
     bool _enabled = true; ///< Input enabled flag
     bool idleFired = true; ///< True if input IDLE event has fired
-    unsigned long lastEventMs = millis(); ///< number of milliseconds since the last event
+    uint32_t lastEventMs = InputEventsClock::now(); ///< number of milliseconds since the last event
     unsigned long idleTimeout = 10000; ///< The idle timeout in milliseconds
 
 
@@ -61,9 +66,9 @@ class EventInputBase {
     /**
      * @brief Update the state of the input.
      * 
-     * @details *Must* be called from within <code>loop()</code>
+     * @details *Must* be called from within <code>loop()</code> unless the input has been added to an InputManager.
      */
-    void update();
+    virtual void update();
 
     /**
      * @brief Returns true if input is enabled.
@@ -106,7 +111,7 @@ class EventInputBase {
     /** 
      * @brief Returns the number of ms since any event was fired for this input
      */
-    unsigned long msSinceLastEvent() { return millis() - lastEventMs; }
+    unsigned long msSinceLastEvent() { return InputEventsClock::now() - lastEventMs; }
 
     /**
      * @brief Return true if no activity for  longer than setIdleTimeout - irrespective of whether the 
@@ -115,7 +120,7 @@ class EventInputBase {
      * @return true Idle timer has ended
      * @return false  Not idle
      */
-    bool isIdle() { return (millis() - lastEventMs) > idleTimeout; }
+    bool isIdle() { return (InputEventsClock::now() - lastEventMs) > idleTimeout; }
 
     /**
      * @brief Reset the idle timer. The IDLE event will fire setIdleTimeout ms
@@ -125,6 +130,60 @@ class EventInputBase {
     void resetIdleTimer();
     ///@}
 
+    ///@{
+    /**
+     * @name Scheduling
+     * @details These methods allow an InputManager (or your sketch) to skip the update() of inputs that have
+     * nothing to do and to find out when the next time based event is due.
+     */
+    /**
+     * @brief Returns true if the input has a pending time based event or state change and sets deadlineMs to when it is due.
+     *
+     * @details The base implementation covers the IDLE timeout. Derived classes add their own deadlines,
+     * eg LONG_PRESS repeat, multi click expiry, debounce settle and encoder rate limit.
+     *
+     * @param deadlineMs Set to the InputEventsClock time at which update() next needs to be called.
+     * @return true A deadline is pending
+     * @return false No deadline is pending
+     */
+    virtual bool nextDeadline(uint32_t& deadlineMs);
+
+    /**
+     * @brief Returns true if the pin(s) or position of the input have changed since the last update().
+     *
+     * @details This is a cheap check (eg a single pin read). The default returns true for inputs that cannot tell
+     * without a full update() (eg EventAnalog).
+     */
+    virtual bool hasInputChanged() { return true; }
+
+    /**
+     * @brief Arm the input's pin(s) as wake sources with the SleepAdapter.
+     *
+     * @return true A change on any of the input's pins will wake the MCU
+     * @return false The default - the input cannot wake the MCU (eg EventAnalog or EventEncoder)
+     */
+    virtual bool attachWakeSource(SleepAdapter& sleepAdapter) { return false; }
+    ///@}
+
+    ///@{
+    /**
+     * @name Event Queue
+     * @details By default, callbacks are called from within update(). With an EventQueue, events are pushed into the
+     * queue and the callbacks are called by EventQueue::dispatch().
+     */
+    /**
+     * @brief Queue events rather than calling the callback from within update().
+     *
+     * @param queue eg a FixedEventQueue or nullptr to call the callback directly (default).
+     */
+    void setEventQueue(EventQueue* queue) { eventQueue = queue; }
+
+    /**
+     * @brief Returns the EventQueue or nullptr if not set.
+     */
+    EventQueue* getEventQueue() { return eventQueue; }
+    ///@}
+
     ///@{
     /**
      * @name Blocking and Allowing events
@@ -208,6 +267,24 @@ protected:
      */
     virtual void invoke(InputEventType et) = 0;
 
+    /**
+     * @brief To be overriden by derived classes. Calls the callback function without any checks.
+     *
+     * @param et Enum of type <code>InputEventType</code>
+     */
+    virtual void invokeCallback(InputEventType et) = 0;
+
+    /**
+     * @brief If an EventQueue is set, push the event into the queue and return true. Otherwise return false and the
+     * caller should call the callback directly.
+     */
+    bool enqueue(InputEventType et);
+
+    /**
+     * @brief The payload for a QueuedEvent. Can be overriden by derived classes, default is 0.
+     */
+    virtual int32_t eventPayload(InputEventType et) { return 0; }
+
     /**
      * @brief Can be ovrriden by derived classes but base method must be called.
      */
@@ -221,25 +298,35 @@ protected:
      */
     virtual void onIdle();
 
+    /**
+     * @brief Helper for nextDeadline() overrides. Sets deadlineMs to candidateMs if there is no deadline yet or candidateMs is earlier.
+     *
+     * @param found Set to true if there is a deadline
+     * @param deadlineMs The earliest deadline so far
+     * @param candidateMs The deadline to compare
+     */
+    static void mergeDeadline(bool& found, uint32_t& deadlineMs, uint32_t candidateMs);
+
 
 
 
 private:
+    EventInputBase* nextInput = nullptr; ///< Intrusive link used by InputManager (no heap required)
+    EventInputBase* timerNext = nullptr; ///< Intrusive timer slot links used by TimerWheel
+    EventInputBase* timerPrev = nullptr;
+    uint32_t timerDueMs = 0; ///< The deadline scheduled with TimerWheel
+    uint8_t timerSlot = 0xFF; ///< The TimerWheel slot (or TimerWheel::NOT_SCHEDULED/TimerWheel::DUE)
+    EventQueue* eventQueue = nullptr; ///< Set if events are queued rather than called directly
+
+    /**
+     * @brief Called by EventQueue::dispatch().
+     */
+    void dispatchEvent(InputEventType et) {
+        if ( callbackIsSet ) invokeCallback(et);
+    }
     //uint8_t excludedEvents[4] = {0};
     uint8_t excludedEvents[(static_cast<uint8_t>(InputEventType::COUNT) + 7) / 8] = {0};
 
-/// \cond DO_NOT_DOCUMENT
-#ifndef FUNCTIONAL_SUPPORTED
-public:
-    void setOwner(void *own) { owner = own; }
-    void *getOwner() { return owner; }
-
-protected:
-    void *owner = nullptr;
-#endif
-/// \endcond
-
-
 };
 
 #endif
\ No newline at end of file
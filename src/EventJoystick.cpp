@@ -12,15 +12,8 @@
 
 EventJoystick::EventJoystick(byte analogX, byte analogY, uint8_t adcBits /*=10*/)
     : x(analogX, adcBits), y(analogY, adcBits) {
-        #ifdef FUNCTIONAL_SUPPORTED
-        x.setCallback([&](InputEventType et, EventAnalog &enc) { onInputXCallback(et, enc); });
-        y.setCallback([&](InputEventType et, EventAnalog &enc) { onInputYCallback(et, enc); });
-        #else
-        x.setOwner(this);
-        x.setCallback(EventJoystick::analogXCallback);
-        y.setOwner(this);
-        y.setCallback(EventJoystick::analogYCallback);
-        #endif
+        x.setCallback([this](InputEventType et, EventAnalog &enc) { onInputXCallback(et, enc); });
+        y.setCallback([this](InputEventType et, EventAnalog &enc) { onInputYCallback(et, enc); });
 }
 
 void EventJoystick::begin() {
@@ -63,10 +56,24 @@ void EventJoystick::unsetCallback() {
 }
 
 void EventJoystick::update() {
+    InputEventsClock::Snapshot now; // Both axis share the same time
     x.update();
     y.update();
 }
 
+bool EventJoystick::nextDeadline(uint32_t& deadlineMs) {
+    bool found = x.nextDeadline(deadlineMs);
+    uint32_t ms;
+    if ( y.nextDeadline(ms) ) {
+        mergeDeadline(found, deadlineMs, ms);
+    }
+    return found;
+}
+
+bool EventJoystick::hasInputChanged() {
+    return x.hasInputChanged() || y.hasInputChanged();
+}
+
 
 void EventJoystick::setStartValues() {
     x.setStartValue();
@@ -124,9 +131,19 @@ void EventJoystick::setRateLimit(uint16_t ms) {
 
 
 void EventJoystick::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventJoystick::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventJoystick::eventPayload(InputEventType et) {
+    if ( et == InputEventType::CHANGED_X ) return x.position();
+    if ( et == InputEventType::CHANGED_Y ) return y.position();
+    return 0;
 }
 
 void EventJoystick::onEnabled() {
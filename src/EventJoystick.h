@@ -29,17 +29,10 @@ class EventJoystick : public EventInputBase {
 
 protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventJoystick &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventJoystick &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventJoystick &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
@@ -52,6 +45,12 @@ protected:
      * @param et Enum of type <code>InputEventType</code>
      */
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The X or Y position for CHANGED_X and CHANGED_Y.
+     */
+    int32_t eventPayload(InputEventType et) override;
 
     void onEnabled() override;
     void onDisabled() override;
@@ -107,23 +106,15 @@ public:
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventJoystick::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventJoystick&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventJoystick &ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -137,7 +128,17 @@ public:
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update() override;
+
+    /**
+     * @brief Returns the earliest deadline of the x and y axis.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+
+    /**
+     * @brief Returns true if either axis has changed.
+     */
+    bool hasInputChanged() override;
 
     /**
      * @brief Resets the state of the input: silently enables if disabled, clears any blocked events, sets inputId & inputValue back to 0 and prevents IDLE event firing.
@@ -303,23 +304,6 @@ protected:
      */
     void onInputYCallback(InputEventType et, EventInputBase & ie);
 
-private:
-
-
-#ifndef FUNCTIONAL_SUPPORTED
-private:
-    static void analogXCallback(InputEventType et, EventAnalog &enc) {
-        EventJoystick *instance = static_cast<EventJoystick *>(enc.getOwner());
-        if (instance) instance->onInputXCallback(et, enc);
-    }
-
-    static void analogYCallback(InputEventType et, EventAnalog &enc) {
-        EventJoystick *instance = static_cast<EventJoystick *>(enc.getOwner());
-        if (instance) instance->onInputYCallback(et, enc);
-    }
-#endif
-
-
 };
 
 
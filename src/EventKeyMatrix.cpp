@@ -0,0 +1,295 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "EventKeyMatrix.h"
+
+EventKeyMatrix::EventKeyMatrix(const byte* rowPinList, uint8_t rowCount, const byte* columnPinList, uint8_t columnCount, uint8_t maxActive /*=4*/)
+    : rows(rowCount < 1 ? 1 : (rowCount > MAX_ROWS ? MAX_ROWS : rowCount)),
+      columns(columnCount < 1 ? 1 : (columnCount > MAX_COLUMNS ? MAX_COLUMNS : columnCount))
+    {
+        allocate(rowPinList, maxActive);
+        columnPins = new byte[columns];
+        memcpy(columnPins, columnPinList, columns);
+    }
+
+EventKeyMatrix::EventKeyMatrix(const byte* rowPinList, uint8_t rowCount, GpioExpanderAdapter& columnExpander, uint8_t columnCount, uint8_t maxActive /*=4*/)
+    : columnExpander(&columnExpander),
+      rows(rowCount < 1 ? 1 : (rowCount > MAX_ROWS ? MAX_ROWS : rowCount)),
+      columns(columnCount < 1 ? 1 : (columnCount > MAX_COLUMNS ? MAX_COLUMNS : columnCount))
+    {
+        allocate(rowPinList, maxActive);
+    }
+
+EventKeyMatrix::~EventKeyMatrix() {
+    delete[] rowPins;
+    delete[] columnPins;
+    delete[] debouncers;
+    delete[] pressed;
+    delete[] activeKeys;
+}
+
+void EventKeyMatrix::allocate(const byte* rowPinList, uint8_t maxActive) {
+    columnMask = columns >= 32 ? 0xFFFFFFFF : ((uint32_t)1 << columns) - 1;
+    rowPins = new byte[rows];
+    memcpy(rowPins, rowPinList, rows);
+    debouncers = new VerticalCounterDebouncer<uint32_t>[rows];
+    pressed = new uint32_t[rows]();
+    maxActiveKeys = maxActive < 1 ? 1 : maxActive;
+    activeKeys = new ActiveKey[maxActiveKeys];
+}
+
+void EventKeyMatrix::begin() {
+    for (uint8_t r = 0; r < rows; r++) {
+        pinMode(rowPins[r], INPUT);
+    }
+    if ( columnExpander ) {
+        for (uint8_t c = 0; c < columns; c++) {
+            columnExpander->attachPin(c, INPUT_PULLUP);
+        }
+    } else {
+        for (uint8_t c = 0; c < columns; c++) {
+            pinMode(columnPins[c], INPUT_PULLUP);
+        }
+        #if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+        // If the columns are consecutive bits of one port, read them with a single register read and a shift
+        columnPort = nullptr;
+        uint8_t port = digitalPinToPort(columnPins[0]);
+        uint32_t firstMask = digitalPinToBitMask(columnPins[0]);
+        bool consecutive = firstMask != 0;
+        for (uint8_t c = 1; consecutive && c < columns; c++) {
+            consecutive = digitalPinToPort(columnPins[c]) == port
+                && (uint32_t)digitalPinToBitMask(columnPins[c]) == (firstMask << c);
+        }
+        if ( consecutive ) {
+            columnPort = portInputRegister(port);
+            columnShift = __builtin_ctzl(firstMask);
+        }
+        #endif
+    }
+    InputEventsClock::Snapshot now;
+    for (uint8_t r = 0; r < rows; r++) {
+        uint32_t initial = readRow(r);
+        debouncers[r].begin(initial);
+        pressed[r] = initial; // As EventButton, a key held at startup does not fire PRESSED
+    }
+    lastScanMs = InputEventsClock::now();
+}
+
+void EventKeyMatrix::unsetCallback() {
+    callbackFunction = nullptr;
+    EventInputBase::unsetCallback();
+}
+
+void EventKeyMatrix::update() {
+    if ( _enabled ) {
+        InputEventsClock::Snapshot now; // All durations in this update use the same time
+        if ( InputEventsClock::now() - lastScanMs >= scanIntervalMs ) {
+            lastScanMs = InputEventsClock::now();
+            scan();
+        }
+        updateTimers();
+        EventInputBase::update();
+    }
+}
+
+bool EventKeyMatrix::nextDeadline(uint32_t& deadlineMs) {
+    bool found = EventInputBase::nextDeadline(deadlineMs);
+    if ( !_enabled ) return found;
+    mergeDeadline(found, deadlineMs, lastScanMs + scanIntervalMs);
+    for (uint8_t i = 0; i < maxActiveKeys; i++) {
+        ActiveKey& a = activeKeys[i];
+        if ( a.key == NO_KEY ) continue;
+        if ( a.pressed ) {
+            mergeDeadline(found, deadlineMs, a.changedMs + longClickDuration + (uint32_t)a.longPressCount * longPressInterval + 1);
+        } else {
+            mergeDeadline(found, deadlineMs, a.changedMs + multiClickInterval + 1);
+        }
+    }
+    return found;
+}
+
+void EventKeyMatrix::scan() {
+    uint8_t rowsWithKeys = 0;
+    for (uint8_t r = 0; r < rows; r++) {
+        if ( debouncers[r].update(readRow(r)) ) rowsWithKeys++;
+    }
+    ghosting = false;
+    for (uint8_t r = 0; r < rows; r++) {
+        uint32_t state = debouncers[r].read();
+        uint32_t released = pressed[r] & ~state;
+        uint32_t presses = state & ~pressed[r];
+        if ( presses && antiGhosting && rowsWithKeys > 1 ) {
+            uint32_t ghost = presses & ghostColumns(r);
+            if ( ghost ) {
+                presses &= ~ghost;
+                ghosting = true;
+                if ( ghosts < 0xFFFF ) ghosts++;
+            }
+        }
+        if ( !(released | presses) ) continue;
+        pressed[r] = (pressed[r] & ~released) | presses;
+        uint16_t first = (uint16_t)r * columns;
+        for (; released; released &= released - 1) {
+            keyReleased(first + __builtin_ctzl(released));
+        }
+        for (; presses; presses &= presses - 1) {
+            keyPressed(first + __builtin_ctzl(presses));
+        }
+    }
+}
+
+uint32_t EventKeyMatrix::ghostColumns(uint8_t row) {
+    // Two rows sharing two or more columns form a rectangle, any corner of which may be a ghost
+    uint32_t state = debouncers[row].read();
+    uint32_t ghost = 0;
+    for (uint8_t r = 0; r < rows; r++) {
+        if ( r == row ) continue;
+        uint32_t common = state & debouncers[r].read();
+        if ( common & (common - 1) ) ghost |= common;
+    }
+    return ghost;
+}
+
+uint32_t EventKeyMatrix::readRow(uint8_t row) {
+    byte pin = rowPins[row];
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+    if ( settleMicros ) delayMicroseconds(settleMicros);
+    uint32_t keys = readColumns();
+    digitalWrite(pin, HIGH); // Briefly drive HIGH to pull the columns back up, then release the row
+    pinMode(pin, INPUT);
+    return keys;
+}
+
+uint32_t EventKeyMatrix::readColumns() {
+    if ( columnExpander ) {
+        columnExpander->update();
+        return ~columnExpander->readAll() & columnMask;
+    }
+    #if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+    if ( columnPort ) {
+        return ~((uint32_t)*columnPort >> columnShift) & columnMask;
+    }
+    #endif
+    uint32_t keys = 0;
+    for (uint8_t c = 0; c < columns; c++) {
+        if ( digitalRead(columnPins[c]) == LOW ) keys |= (uint32_t)1 << c;
+    }
+    return keys;
+}
+
+void EventKeyMatrix::keyPressed(uint16_t key) {
+    ActiveKey* a = findKey(key);
+    if ( !a ) {
+        a = findKey(NO_KEY);
+        if ( a ) {
+            a->key = key;
+            a->clickCount = 0;
+        }
+    }
+    if ( a ) {
+        a->pressed = true;
+        a->longPressCount = 0;
+        a->changedMs = InputEventsClock::now();
+    }
+    fire(InputEventType::PRESSED, a, key);
+}
+
+void EventKeyMatrix::keyReleased(uint16_t key) {
+    ActiveKey* a = findKey(key);
+    if ( a ) {
+        uint32_t now = InputEventsClock::now();
+        a->previousDurationMs = now - a->changedMs;
+        a->changedMs = now;
+        a->pressed = false;
+        if ( a->clickCount < 0xFF ) a->clickCount++;
+    }
+    fire(InputEventType::RELEASED, a, key);
+}
+
+void EventKeyMatrix::updateTimers() {
+    uint32_t now = InputEventsClock::now();
+    for (uint8_t i = 0; i < maxActiveKeys; i++) {
+        ActiveKey& a = activeKeys[i];
+        if ( a.key == NO_KEY ) continue;
+        uint32_t duration = now - a.changedMs;
+        if ( a.pressed ) {
+            resetIdleTimer();
+            if ( duration > longClickDuration + (uint32_t)a.longPressCount * longPressInterval ) {
+                a.longPressCount++;
+                if ( repeatLongPress || a.longPressCount == 1 ) {
+                    fire(InputEventType::LONG_PRESS, &a, a.key);
+                }
+            }
+        } else if ( duration > multiClickInterval ) {
+            uint16_t key = a.key;
+            a.key = NO_KEY; // Free the slot before the callback so it can be reused
+            if ( a.previousDurationMs > longClickDuration ) {
+                fire(InputEventType::LONG_CLICKED, &a, key);
+            } else if ( a.clickCount == 1 ) {
+                fire(InputEventType::CLICKED, &a, key);
+            } else if ( a.clickCount == 2 ) {
+                fire(InputEventType::DOUBLE_CLICKED, &a, key);
+            } else {
+                fire(InputEventType::MULTI_CLICKED, &a, key);
+            }
+        }
+    }
+}
+
+EventKeyMatrix::ActiveKey* EventKeyMatrix::findKey(uint16_t key) {
+    for (uint8_t i = 0; i < maxActiveKeys; i++) {
+        if ( activeKeys[i].key == key ) return &activeKeys[i];
+    }
+    return nullptr;
+}
+
+void EventKeyMatrix::fire(InputEventType et, ActiveKey* active, uint16_t key) {
+    currentKey = key;
+    currentClickCount = active ? active->clickCount : 0;
+    currentLongPressCount = active ? active->longPressCount : 0;
+    currentPreviousDuration = active ? active->previousDurationMs : 0;
+    invoke(et);
+    currentKey = NO_KEY;
+}
+
+bool EventKeyMatrix::isPressed(uint16_t key) {
+    if ( key >= keyCount() ) return false;
+    return (pressed[key / columns] >> (key % columns)) & 1;
+}
+
+uint16_t EventKeyMatrix::pressedCount() {
+    uint16_t n = 0;
+    for (uint8_t r = 0; r < rows; r++) {
+        for (uint32_t keys = pressed[r]; keys; keys &= keys - 1) {
+            n++;
+        }
+    }
+    return n;
+}
+
+void EventKeyMatrix::invoke(InputEventType et) {
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventKeyMatrix::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventKeyMatrix::eventPayload(InputEventType et) {
+    return currentKey == NO_KEY ? 0 : currentKey;
+}
+
+void EventKeyMatrix::onDisabled() {
+    for (uint8_t i = 0; i < maxActiveKeys; i++) {
+        activeKeys[i] = ActiveKey();
+    }
+    EventInputBase::onDisabled();
+}
@@ -0,0 +1,334 @@
+/*
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef EVENT_KEY_MATRIX_H
+#define EVENT_KEY_MATRIX_H
+
+#include "Arduino.h"
+#include "EventInputBase.h"
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/VerticalCounterDebouncer.h"
+
+/**
+ * @brief The EventKeyMatrix class is for a matrix (grid) of buttons - keypads, keyboards and control surfaces - where
+ * each key connects a row pin to a column pin.
+
+   @details One EventKeyMatrix fires the same events as an EventButton for every key in the matrix. In the callback,
+   key() is the index of the key that fired the event (row * columnCount() + column).
+
+   The matrix is scanned every scanInterval (default 3ms): each row in turn is driven LOW and the columns (pulled up)
+   are read as one word, so a scan costs one column read per row whatever the number of columns. Each row's columns
+   are debounced together by a VerticalCounterDebouncer (four scans, 9-12ms by default). Up to 32 rows and 32 columns.
+
+   The columns can be MCU pins or the first columnCount pins of a GpioExpanderAdapter (eg an MCP23017), which is
+   updated once per row.
+
+   Without a diode on each key, pressing three keys on the corners of a rectangle makes the fourth corner look pressed
+   (a 'ghost'). With anti-ghosting (the default), a new press is ignored while it is part of such a rectangle. If your
+   matrix has diodes, call setAntiGhosting(false) to allow any combination.
+
+   Clicks, long presses and durations are timed for up to maxActiveKeys (default 4) keys at once. Keys pressed beyond
+   that only fire PRESSED and RELEASED.
+
+The following InputEventTypes are fired by EventKeyMatrix:
+  - InputEventType::ENABLED - fired when the input is enabled.
+  - InputEventType::DISABLED - fired when the input is disabled.
+  - InputEventType::IDLE - fired after no other event (except <code>ENABLED</code> & <code>DISABLED</code>) has been fired for a specified time.
+  - InputEventType::PRESSED - fired after (as) a key is pressed
+  - InputEventType::RELEASED - fired after a key is released.
+  - InputEventType::CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released once.
+  - InputEventType::DOUBLE_CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released twice.
+  - InputEventType::MULTI_CLICKED - fired after <code>RELEASED</code> if not <code>LONG_CLICKED</code> and the key is pressed and released more than twice.
+  - InputEventType::LONG_PRESS - fired *during* a long press. Will repeat by default but this can be turned off.
+  - InputEventType::LONG_CLICKED - fired *after* a long press.
+ *
+ */
+class EventKeyMatrix : public EventInputBase {
+
+protected:
+
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventKeyMatrix &ie)> CallbackFunction;
+
+    /**
+     * @brief The callback function member.
+     */
+    CallbackFunction callbackFunction = nullptr;
+
+    void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent is the key() for all key events.
+     */
+    int32_t eventPayload(InputEventType et) override;
+
+    void onDisabled() override;
+
+public:
+
+    static constexpr uint8_t MAX_ROWS = 32;
+    static constexpr uint8_t MAX_COLUMNS = 32;
+    static constexpr uint16_t NO_KEY = 0xFFFF; ///< key() when the event is not for a key (eg IDLE)
+
+    ///@{
+    /**
+     * @name Constructors
+     */
+    /**
+     * @brief Construct an EventKeyMatrix with the rows and columns on MCU pins.
+     *
+     * @param rowPins The row pins (copied)
+     * @param rowCount The number of rows (1-32)
+     * @param columnPins The column pins (copied)
+     * @param columnCount The number of columns (1-32)
+     * @param maxActiveKeys The number of keys that can be timed (for clicks and long presses) at once
+     */
+    EventKeyMatrix(const byte* rowPins, uint8_t rowCount, const byte* columnPins, uint8_t columnCount, uint8_t maxActiveKeys = 4);
+
+    /**
+     * @brief Construct an EventKeyMatrix with the rows on MCU pins and the columns on a GPIO expander.
+     *
+     * @param rowPins The row pins (copied)
+     * @param rowCount The number of rows (1-32)
+     * @param columns The expander. Columns are pins 0 to columnCount - 1. Its begin() is not called by the matrix.
+     * @param columnCount The number of columns (1-32)
+     * @param maxActiveKeys The number of keys that can be timed (for clicks and long presses) at once
+     */
+    EventKeyMatrix(const byte* rowPins, uint8_t rowCount, GpioExpanderAdapter& columns, uint8_t columnCount, uint8_t maxActiveKeys = 4);
+    ///@}
+
+    ///@{
+    /**
+     * @name Common Methods
+     */
+
+    /**
+     * @brief Initialise the EventKeyMatrix
+     *
+     * @details *Must* be called from within <code>setup()</code>
+     */
+    void begin() override;
+
+    /**
+     * @brief Set the Callback function.
+     *
+     * @param f A function of type <code>EventKeyMatrix::CallbackFunction</code> type.
+     */
+    void setCallback(CallbackFunction f) {
+        callbackFunction = f;
+        callbackIsSet = true;
+    }
+
+    /**
+     * @brief Set the Callback function to a class method.
+     *
+     * @param instance The instance of a class implementing a CallbackFunction method.
+     * @param method The class method of type <code>EventKeyMatrix::CallbackFunction</code> type.
+     */
+    template <typename T>
+    void setCallback(T* instance, void (T::*method)(InputEventType, EventKeyMatrix&)) {
+        callbackFunction = CallbackFunction(instance, method);
+        callbackIsSet = true;
+    }
+
+    /**
+     * @brief Unset a previously set callback function or method.
+     */
+    void unsetCallback() override;
+
+    /**
+     * @brief Scan the matrix (if a scan is due) and fire the key events.
+     *
+     * @details *Must* be called from within <code>loop()</code>
+     */
+    void update() override;
+
+    /**
+     * @brief Adds the next scan and any click or long press timing to the IDLE deadline.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+    ///@}
+
+    ///@{
+    /**
+     * @name Getting the State
+     */
+
+    /**
+     * @brief The key that fired the current event (row * columnCount() + column) or NO_KEY.
+     */
+    uint16_t key() { return currentKey; }
+
+    /**
+     * @brief The row of key().
+     */
+    uint8_t row() { return currentKey == NO_KEY ? 0 : currentKey / columns; }
+
+    /**
+     * @brief The column of key().
+     */
+    uint8_t column() { return currentKey == NO_KEY ? 0 : currentKey % columns; }
+
+    /**
+     * @brief The number of clicks of key() (for CLICKED, DOUBLE_CLICKED and MULTI_CLICKED).
+     */
+    uint8_t clickCount() { return currentClickCount; }
+
+    /**
+     * @brief The number of times LONG_PRESS has fired for key().
+     */
+    uint16_t longPressCount() { return currentLongPressCount; }
+
+    /**
+     * @brief For RELEASED and LONG_CLICKED, the duration of the press of key() in milliseconds.
+     */
+    uint32_t previousDuration() { return currentPreviousDuration; }
+
+    /**
+     * @brief Returns true if a key is (debounced) pressed.
+     */
+    bool isPressed(uint16_t key);
+
+    /**
+     * @brief Returns true if a key is (debounced) pressed.
+     */
+    bool isPressed(uint8_t row, uint8_t column) { return isPressed((uint16_t)(row * columns + column)); }
+
+    /**
+     * @brief The pressed keys of a row, one bit per column.
+     */
+    uint32_t pressedColumns(uint8_t row) { return row < rows ? pressed[row] : 0; }
+
+    /**
+     * @brief The number of keys pressed.
+     */
+    uint16_t pressedCount();
+
+    /**
+     * @brief Returns true if a press is currently being ignored by anti-ghosting.
+     */
+    bool isGhosting() { return ghosting; }
+
+    /**
+     * @brief The number of scans on which anti-ghosting ignored a press since begin().
+     */
+    uint16_t ghostCount() { return ghosts; }
+
+    uint8_t rowCount() { return rows; }
+    uint8_t columnCount() { return columns; }
+    uint16_t keyCount() { return (uint16_t)rows * columns; }
+    ///@}
+
+    ///@{
+    /**
+     * @name Configuration Settings
+     */
+    /**
+     * @brief Set the interval between scans. The debounce time is four intervals. Default is 3ms.
+     */
+    void setScanInterval(uint8_t intervalMs = 3) { scanIntervalMs = intervalMs; }
+
+    /**
+     * @brief Set the time in microseconds for the columns to settle after a row is driven. Default is 5us.
+     */
+    void setSettleMicros(uint8_t us = 5) { settleMicros = us; }
+
+    /**
+     * @brief Ignore presses that could be ghosts (default true). Turn off if every key has a diode.
+     */
+    void setAntiGhosting(bool enable = true) { antiGhosting = enable; }
+
+    /**
+     * @brief Choose whether to repeat the LONG_PRESS event. (true by default)
+     */
+    void enableLongPressRepeat(bool repeat = true) { repeatLongPress = repeat; }
+
+    /**
+     * @brief Set the duration of the *first* LONG_PRESS (and the minimum for LONG_CLICKED). Default is 750ms.
+     */
+    void setLongClickDuration(uint16_t longDurationMs = 750) { longClickDuration = longDurationMs; }
+
+    /**
+     * @brief Set the interval between repeated LONG_PRESS events. Default is 500ms.
+     */
+    void setLongPressInterval(uint16_t intervalMs = 500) { longPressInterval = intervalMs; }
+
+    /**
+     * @brief Set the multi click interval. Default is 250ms.
+     */
+    void setMultiClickInterval(uint16_t intervalMs = 250) { multiClickInterval = intervalMs; }
+    ///@}
+
+    virtual ~EventKeyMatrix();
+
+private:
+
+    /**
+     * @brief The timing of a key that is pressed or waiting for its click to fire.
+     */
+    struct ActiveKey {
+        uint16_t key = NO_KEY;
+        bool pressed = false;
+        uint8_t clickCount = 0;
+        uint16_t longPressCount = 0;
+        uint32_t changedMs = 0;
+        uint32_t previousDurationMs = 0;
+    };
+
+    byte* rowPins;
+    byte* columnPins = nullptr;
+    GpioExpanderAdapter* columnExpander = nullptr;
+    uint8_t rows;
+    uint8_t columns;
+    uint32_t columnMask;
+
+    VerticalCounterDebouncer<uint32_t>* debouncers;
+    uint32_t* pressed;
+    ActiveKey* activeKeys;
+    uint8_t maxActiveKeys;
+
+    uint32_t lastScanMs = 0;
+    uint8_t scanIntervalMs = 3;
+    uint8_t settleMicros = 5;
+    bool antiGhosting = true;
+    bool ghosting = false;
+    uint16_t ghosts = 0;
+
+    uint16_t currentKey = NO_KEY;
+    uint8_t currentClickCount = 0;
+    uint16_t currentLongPressCount = 0;
+    uint32_t currentPreviousDuration = 0;
+
+    uint16_t multiClickInterval = 250;
+    uint16_t longClickDuration = 750;
+    uint16_t longPressInterval = 500;
+    bool repeatLongPress = true;
+
+    // Reading the columns of pins as a port word, see begin()
+    #if defined(portInputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+    typedef decltype(portInputRegister(digitalPinToPort(0))) InputRegister;
+    InputRegister columnPort = nullptr;
+    uint8_t columnShift = 0;
+    #endif
+
+    void allocate(const byte* rowPinList, uint8_t maxActive);
+    void scan();
+    uint32_t readRow(uint8_t row);
+    uint32_t readColumns();
+    uint32_t ghostColumns(uint8_t row);
+    void keyPressed(uint16_t key);
+    void keyReleased(uint16_t key);
+    void updateTimers();
+    ActiveKey* findKey(uint16_t key);
+    void fire(InputEventType et, ActiveKey* active, uint16_t key);
+};
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "EventQueue.h"
+#include "EventInputBase.h"
+#include "InterruptLock.h"
+
+bool EventQueue::push(const QueuedEvent& event) {
+    uint8_t h = head; //Only written here
+    if ( (uint8_t)(h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE)) >= cap ) {
+        if ( overflows < 0xFFFF ) overflows++;
+        if ( overflowPolicy == OverflowPolicy::DROP_NEWEST ) return false;
+        __atomic_store_n(&tail, (uint8_t)(tail + 1), __ATOMIC_RELEASE); //DROP_OLDEST - pop() holds off interrupts while it reads
+    }
+    buffer[h & mask] = event;
+    __atomic_store_n(&head, (uint8_t)(h + 1), __ATOMIC_RELEASE); //Publish after the event has been written
+    return true;
+}
+
+bool EventQueue::pop(QueuedEvent& event) {
+    InterruptLock lock(overflowPolicy == OverflowPolicy::DROP_OLDEST);
+    uint8_t t = tail;
+    if ( t == __atomic_load_n(&head, __ATOMIC_ACQUIRE) ) return false;
+    event = buffer[t & mask];
+    __atomic_store_n(&tail, (uint8_t)(t + 1), __ATOMIC_RELEASE); //Free the slot after the event has been copied
+    return true;
+}
+
+uint8_t EventQueue::dispatch(uint8_t maxEvents /*=0xFF*/) {
+    uint8_t count = 0;
+    while ( count < maxEvents && pop(dispatching) ) {
+        dispatching.input->dispatchEvent(dispatching.type);
+        count++;
+    }
+    dispatching.input = nullptr;
+    return count;
+}
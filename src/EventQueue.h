@@ -0,0 +1,165 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_EVENT_QUEUE_H
+#define INPUT_EVENTS_EVENT_QUEUE_H
+
+#include <Arduino.h>
+#include "InputEvents.h"
+
+class EventInputBase;
+
+/**
+ * @brief A compact record of an event waiting to be dispatched.
+ */
+struct QueuedEvent {
+    EventInputBase* input; ///< The input that fired the event
+    InputEventType type; ///< The event type
+    uint32_t timestampMs; ///< InputEventsClock::now() when the event fired
+    int32_t payload; ///< Input specific value at the time of the event (eg encoder increment, analog position, click count)
+};
+
+/**
+ * @brief A fixed capacity single producer, single consumer (SPSC) ring buffer of QueuedEvent.
+ *
+ * @details When an input has an EventQueue (see EventInputBase::setEventQueue()), its events are pushed into the queue
+ * instead of calling the callback from within update(). Call dispatch() (normally from <code>loop()</code>) to drain the
+ * queue to the callbacks. This means a slow callback (eg a display redraw) does not delay sampling of other inputs and
+ * update() can be called from a timer interrupt.
+ *
+ * With the default DROP_NEWEST policy push() and pop() are lock free - the producer (update()) only writes the head index
+ * and the consumer (dispatch()) only writes the tail index. Indices are single bytes so they are read and written atomically
+ * on all boards. Each index is published with a release store and read with an acquire load, so the event written to
+ * (or copied from) a slot is visible before the index that hands the slot over, even where producer and consumer run
+ * on different cores.
+ *
+ * With DROP_OLDEST, push() overwrites the oldest event when full, so pop() briefly disables interrupts while it copies
+ * an event (and then restores their previous state). This is safe when update() is called from an interrupt on the
+ * same core as dispatch().
+ *
+ * Use FixedEventQueue to create a queue with its own storage.
+ *
+ */
+class EventQueue {
+
+public:
+
+    /**
+     * @brief What happens to an event pushed into a full queue.
+     */
+    enum class OverflowPolicy : uint8_t {
+        DROP_NEWEST, ///< Discard the new event (default)
+        DROP_OLDEST  ///< Discard the oldest event to make room
+    };
+
+    /**
+     * @brief Construct an EventQueue using external storage.
+     *
+     * @param buffer An array of at least capacity QueuedEvent
+     * @param capacity A power of two, no more than 128
+     */
+    EventQueue(QueuedEvent* buffer, uint8_t capacity)
+        : buffer(buffer), mask(capacity - 1), cap(capacity)
+        { }
+
+    /**
+     * @brief Push an event (producer side). Returns false if the queue was full and the new event was dropped.
+     */
+    bool push(const QueuedEvent& event);
+
+    /**
+     * @brief Pop the oldest event (consumer side). Returns false if the queue is empty.
+     */
+    bool pop(QueuedEvent& event);
+
+    /**
+     * @brief Pop events and send them to their input's callback.
+     *
+     * @param maxEvents The maximum number of events to dispatch (default is all)
+     * @return uint8_t The number of events dispatched
+     */
+    uint8_t dispatch(uint8_t maxEvents = 0xFF);
+
+    /**
+     * @brief The event currently being dispatched. Only valid from within a callback called by dispatch().
+     *
+     * @details Use this to get the timestamp and payload of the event rather than the current state of the input.
+     */
+    const QueuedEvent& current() { return dispatching; }
+
+    /**
+     * @brief The number of events waiting to be dispatched.
+     */
+    uint8_t size() { return (uint8_t)(head - tail); }
+
+    /**
+     * @brief Returns true if there are no events waiting to be dispatched.
+     */
+    bool isEmpty() { return head == tail; }
+
+    /**
+     * @brief The maximum number of events the queue can hold.
+     */
+    uint8_t capacity() { return cap; }
+
+    /**
+     * @brief Set the OverflowPolicy. Default is DROP_NEWEST.
+     */
+    void setOverflowPolicy(OverflowPolicy policy) { overflowPolicy = policy; }
+
+    /**
+     * @brief Get the OverflowPolicy.
+     */
+    OverflowPolicy getOverflowPolicy() { return overflowPolicy; }
+
+    /**
+     * @brief The number of events dropped because the queue was full.
+     */
+    uint16_t overflowCount() { return overflows; }
+
+    /**
+     * @brief Reset the overflow counter.
+     */
+    void resetOverflowCount() { overflows = 0; }
+
+    /**
+     * @brief Discard all waiting events (consumer side).
+     */
+    void clear() { tail = head; }
+
+private:
+    QueuedEvent* buffer;
+    uint8_t mask;
+    uint8_t cap;
+    volatile uint8_t head = 0; ///< Free running, only written by push()
+    volatile uint8_t tail = 0; ///< Free running, only written by pop() (and push() with DROP_OLDEST)
+    volatile uint16_t overflows = 0;
+    OverflowPolicy overflowPolicy = OverflowPolicy::DROP_NEWEST;
+    QueuedEvent dispatching = { nullptr, InputEventType::NONE, 0, 0 };
+};
+
+/**
+ * @brief An EventQueue with storage for CAPACITY events.
+ *
+ * @details Each event takes 11 bytes on AVR (16 on 32 bit boards, with padding).
+ * ```
+ * FixedEventQueue<16> eventQueue;
+ * ```
+ *
+ * @tparam CAPACITY A power of two, no more than 128
+ */
+template <uint8_t CAPACITY>
+class FixedEventQueue : public EventQueue {
+    static_assert(CAPACITY > 0 && CAPACITY <= 128 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two, no more than 128");
+public:
+    FixedEventQueue() : EventQueue(storage, CAPACITY) {}
+private:
+    QueuedEvent storage[CAPACITY];
+};
+
+#endif
@@ -49,6 +49,7 @@ void EventSwitch::unsetCallback() {
 
 void EventSwitch::update() {
     if (_enabled) {
+        InputEventsClock::Snapshot now; // All durations in this update use the same time
         if (changedState()) {
             if (turningOn()) {
                 //previousState = HIGH;
@@ -63,10 +64,36 @@ void EventSwitch::update() {
     }
 }
 
+bool EventSwitch::nextDeadline(uint32_t& deadlineMs) {
+    bool found = EventInputBase::nextDeadline(deadlineMs);
+    uint32_t ms;
+    if ( _enabled && debouncer && debouncer->nextDeadline(ms) ) {
+        mergeDeadline(found, deadlineMs, ms);
+    }
+    return found;
+}
+
+bool EventSwitch::hasInputChanged() {
+    return pinAdapter->read() != currentPinState;
+}
+
+bool EventSwitch::attachWakeSource(SleepAdapter& sleepAdapter) {
+    return pinAdapter->attachWakeSource(sleepAdapter);
+}
+
 void EventSwitch::invoke(InputEventType et) {
-    if ( isInvokable(et) ) {
-        callbackFunction(et, *this);
-    }    
+    if ( isInvokable(et) && !enqueue(et) ) {
+        invokeCallback(et);
+    }
+}
+
+void EventSwitch::invokeCallback(InputEventType et) {
+    callbackFunction(et, *this);
+}
+
+int32_t EventSwitch::eventPayload(InputEventType et) {
+    if ( et == InputEventType::ON || et == InputEventType::OFF ) return previousDuration();
+    return 0;
 }
 
 void EventSwitch::setDebouncer(DebounceAdapter* debounceAdapter) {
@@ -99,8 +126,9 @@ void EventSwitch::changeState(bool newState) {
     previousState = currentState;
     currentState = newState;
     stateChanged = true;
-    durationOfPreviousState = millis() - stateChangeLastTime;
-    stateChangeLastTime = millis();
+    uint32_t now = InputEventsClock::now();
+    durationOfPreviousState = now - stateChangeLastTime;
+    stateChangeLastTime = now;
 }
 
 bool EventSwitch::setDebounceInterval(unsigned int intervalMs) { 
@@ -111,4 +139,4 @@ bool EventSwitch::setDebounceInterval(unsigned int intervalMs) {
     return false;
 }
 
-uint32_t EventSwitch::currentDuration() { return (millis() - stateChangeLastTime); }
+uint32_t EventSwitch::currentDuration() { return (InputEventsClock::now() - stateChangeLastTime); }
@@ -34,17 +34,10 @@ class EventSwitch : public EventInputBase {
 
 protected:
 
-    #if defined(FUNCTIONAL_SUPPORTED)
-        /**
-         * @brief If <code>std::function</code> is supported, this creates the callback type.
-         */
-        typedef std::function<void(InputEventType et, EventSwitch &ie)> CallbackFunction;
-    #else
-        /**
-         * @brief Used to create the callback type as pointer if <code>std::function</code> is not supported.
-         */
-        typedef void (*CallbackFunction)(InputEventType et, EventSwitch &);
-    #endif
+    /**
+     * @brief The callback type. A function, class method or capturing lambda (see InlineDelegate) - no heap is used.
+     */
+    typedef InlineDelegate<void(InputEventType et, EventSwitch &ie)> CallbackFunction;
 
     /**
      * @brief The callback function member.
@@ -57,6 +50,12 @@ protected:
      * @param et Enum of type <code>InputEventType</code>
      */
     void invoke(InputEventType et) override;
+    void invokeCallback(InputEventType et) override;
+
+    /**
+     * @brief The payload for a QueuedEvent. The previous duration for ON and OFF.
+     */
+    int32_t eventPayload(InputEventType et) override;
 
 public:
 
@@ -117,23 +116,15 @@ public:
     /**
      * @brief Set the Callback function to a class method.
      * 
-     * @details Note: This method is only available if <code>std:function</code> is supported.
-     * 
-     * 
      * @param instance The instance of a class implementing a CallbackFunction method.
      * @param method The class method of type <code>EventSwitch::CallbackFunction</code> type.
      */
-    #if defined(FUNCTIONAL_SUPPORTED)
     // Method to set callback with instance and class method
     template <typename T>
     void setCallback(T* instance, void (T::*method)(InputEventType, EventSwitch&)) {
-        // Wrap the method call in a lambda
-        callbackFunction = [instance, method](InputEventType et, EventSwitch &ie) {
-            (instance->*method)(et, ie); // Call the member function on the instance
-        };
+        callbackFunction = CallbackFunction(instance, method);
         callbackIsSet = true;
     }
-    #endif
 
     /**
      * @brief Unset a previously set callback function or method.
@@ -147,7 +138,22 @@ public:
      * 
      * @details *Must* be called from within <code>loop()</code>
      */
-    void update();
+    void update() override;
+
+    /**
+     * @brief Adds debounce settle to the IDLE deadline.
+     */
+    bool nextDeadline(uint32_t& deadlineMs) override;
+
+    /**
+     * @brief Returns true if the pin state differs from the current (debounced) state.
+     */
+    bool hasInputChanged() override;
+
+    /**
+     * @brief Arms the switch pin as a wake source.
+     */
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override;
     ///@}
 
     ///@{
@@ -260,7 +266,7 @@ public:
 private:
 
     PinAdapter* pinAdapter;
-    DebounceAdapter* debouncer;
+    DebounceAdapter* debouncer = nullptr;
 
     bool onState = LOW; //The state that represents 'pressed'
 
@@ -0,0 +1,70 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "ExpanderInputDispatcher.h"
+#include "InputManager.h"
+
+void ExpanderInputDispatcher::subscribe(EventInputBase& input, uint32_t pinMask) {
+    for (uint32_t pins = pinMask & subscribed; pins && manager; pins &= pins - 1) {
+        EventInputBase* previous = inputs[__builtin_ctzl(pins)];
+        //Replaced on all of its pins
+        if ( previous != &input && !isSubscribed(previous, ~pinMask) ) manager->unsubscribed(*previous);
+    }
+    for (uint8_t pin = 0; pin < MAX_PINS; pin++) {
+        if ( pinMask & ((uint32_t)1 << pin) ) inputs[pin] = &input;
+    }
+    subscribed |= pinMask;
+    updateFirstPins();
+    primed = false;
+    if ( manager ) manager->subscribersChanged();
+}
+
+bool ExpanderInputDispatcher::unsubscribe(EventInputBase& input) {
+    bool found = false;
+    for (uint8_t pin = 0; pin < MAX_PINS; pin++) {
+        if ( inputs[pin] != &input ) continue;
+        inputs[pin] = nullptr;
+        subscribed &= ~((uint32_t)1 << pin);
+        found = true;
+    }
+    if ( found ) {
+        updateFirstPins();
+        if ( manager ) {
+            manager->unsubscribed(input);
+            manager->subscribersChanged();
+        }
+    }
+    return found;
+}
+
+bool ExpanderInputDispatcher::isSubscribed(EventInputBase* input, uint32_t pinMask) {
+    for (uint32_t pins = subscribed & pinMask; pins; pins &= pins - 1) {
+        if ( inputs[__builtin_ctzl(pins)] == input ) return true;
+    }
+    return false;
+}
+
+uint8_t ExpanderInputDispatcher::count() {
+    uint8_t n = 0;
+    for (uint32_t pins = firstPins; pins; pins &= pins - 1) {
+        n++;
+    }
+    return n;
+}
+
+void ExpanderInputDispatcher::updateFirstPins() {
+    firstPins = 0;
+    uint32_t seen = 0;
+    for (uint8_t pin = 0; pin < MAX_PINS; pin++) {
+        if ( !inputs[pin] || (seen & ((uint32_t)1 << pin)) ) continue;
+        firstPins |= (uint32_t)1 << pin;
+        for (uint8_t other = pin; other < MAX_PINS; other++) {
+            if ( inputs[other] == inputs[pin] ) seen |= (uint32_t)1 << other;
+        }
+    }
+}
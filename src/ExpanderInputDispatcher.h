@@ -0,0 +1,131 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_EXPANDER_INPUT_DISPATCHER_H
+#define INPUT_EVENTS_EXPANDER_INPUT_DISPATCHER_H
+
+#include <Arduino.h>
+#include "EventInputBase.h"
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+
+class InputManager;
+
+/**
+ * @brief Maps the pins of a GPIO expander to the inputs attached to them so an InputManager only updates the inputs
+ * whose pins have changed.
+ *
+ * @details Subscribe each input attached to the expander (via ExpanderPinAdapter or ExpanderEncoderAdapter) with the
+ * expander pins it uses, then add the dispatcher (rather than the inputs) to an InputManager. On each pass the manager
+ * updates the expander and, with scheduling enabled, only updates the subscribers whose pins are in the expander's
+ * changedMask() or whose deadline has been reached. A panel of 64 buttons on two expanders then costs two bus reads
+ * and a few word operations per pass when nothing is pressed.
+ *
+ * Without scheduling, every enabled subscriber is updated on every pass (as if it had been added to the manager).
+ * Every subscriber is also updated on the first pass after a subscribe() so each input (eg an encoder's quadrature
+ * state) starts from the current pin states.
+ *
+ * The subscriber table has one entry per expander pin (up to 32) and an input can subscribe to several pins, eg the
+ * A and B pins of an encoder and the pin of its button:
+ * ```
+ * HC165ExpanderAdapter expander(DATA_PIN, CLOCK_PIN, SHLD_PIN, 4);
+ * ExpanderInputDispatcher panel(expander);
+ * EventButton button(new ExpanderPinAdapter(0, expander));
+ * EventEncoderButton encoderButton(new ExpanderEncoderAdapter(1, 2, expander), new ExpanderPinAdapter(3, expander));
+ *
+ * panel.subscribe(button, bit(0));
+ * panel.subscribe(encoderButton, bit(1) | bit(2) | bit(3));
+ * inputs.add(panel);
+ * inputs.enableScheduling();
+ * ```
+ * The expander's changedMask() must be accurate - adapters that do not override it report every pin as changed, so
+ * every subscriber is updated on every pass.
+ *
+ * Only the dispatcher is added to the InputManager and a dispatcher can only be added to one InputManager.
+ */
+class ExpanderInputDispatcher {
+
+public:
+
+    static constexpr uint8_t MAX_PINS = 32; ///< The size of the subscriber table
+
+    /**
+     * @brief Construct an ExpanderInputDispatcher
+     *
+     * @param expander The expander adapter. Its begin() is not called by the dispatcher but its update() is called by
+     * the InputManager, so do not call it from <code>loop()</code>.
+     */
+    ExpanderInputDispatcher(GpioExpanderAdapter& expander)
+        : expander(&expander)
+        {}
+
+    /**
+     * @brief Subscribe an input to one or more expander pins.
+     *
+     * @details Use the 'outer' input, eg the EventEncoderButton rather than its EventEncoder. A pin can only have one
+     * subscriber - a later subscribe() to the same pin replaces it. An input replaced on all of its pins is
+     * unsubscribed (see unsubscribe()).
+     *
+     * @param input The input attached to the pins
+     * @param pinMask The expander pins used by the input, one bit per pin (bit 0 is pin 0)
+     */
+    void subscribe(EventInputBase& input, uint32_t pinMask);
+
+    /**
+     * @brief Remove an input from all of its pins.
+     *
+     * @details If the dispatcher has been added to an InputManager, the input's pending deadline is cancelled so the
+     * manager will not update it again. Do not unsubscribe an input from within its own callback unless it uses an
+     * EventQueue - the manager reschedules an input after updating it.
+     *
+     * @return true The input was subscribed
+     */
+    bool unsubscribe(EventInputBase& input);
+
+    /**
+     * @brief The subscriber for an expander pin (or nullptr).
+     */
+    EventInputBase* subscriber(uint8_t pin) { return pin < MAX_PINS ? inputs[pin] : nullptr; }
+
+    /**
+     * @brief The pins that have a subscriber, one bit per pin.
+     */
+    uint32_t subscribedMask() { return subscribed; }
+
+    /**
+     * @brief The number of subscribed inputs.
+     */
+    uint8_t count();
+
+    /**
+     * @brief The expander adapter.
+     */
+    GpioExpanderAdapter& getExpander() { return *expander; }
+
+private:
+    friend class InputManager;
+
+    GpioExpanderAdapter* expander;
+    InputManager* manager = nullptr; ///< Set while added to an InputManager
+    EventInputBase* inputs[MAX_PINS] = {};
+    uint32_t subscribed = 0; ///< Pins with a subscriber
+    uint32_t firstPins = 0; ///< The lowest pin of each subscriber, so each input can be visited once
+    ExpanderInputDispatcher* nextDispatcher = nullptr; ///< Intrusive link used by InputManager
+    bool primed = false; ///< False until every subscriber has been updated once
+
+    /**
+     * @brief Rebuild firstPins after the table has changed.
+     */
+    void updateFirstPins();
+
+    /**
+     * @brief Returns true if the input is subscribed to any of the pins in pinMask.
+     */
+    bool isSubscribed(EventInputBase* input, uint32_t pinMask);
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include <new>
 #include <Adafruit_MCP23X17.h>
 #include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/ExpanderInterrupt.h"
 #include "PinAdapter/PinAdapter.h"
 
 /**
@@ -14,6 +15,9 @@
  *
  * Details: https://learn.adafruit.com/adafruit-mcp23017-i2c-gpio-expander *
  * 
+ * By default every update() reads the pins over I2C. With enableInterrupt() the MCP23017's interrupt-on-change is
+ * used and the pins are only read when its INT line is asserted.
+ * 
  */
 class AdafruitMCP23017ExpanderAdapter : public GpioExpanderAdapter {
 
@@ -73,9 +77,71 @@ public:
      * 
      */
     void update() override {
-        pinStates = mcp->readGPIOAB();
+        uint16_t previous = pinStates;
+        if ( !interrupt.isAttached() ) {
+            pinStates = mcp->readGPIOAB();
+        } else if ( interrupt.takePending() ) {
+            // INTCAP holds a port's pins at the moment of its first change (and reading it clears INT). Only the
+            // port flagged in INTF was captured, the other keeps its previous state. The pins may have changed
+            // again since, so they are read on the next update().
+            uint8_t intPin = mcp->getLastInterruptPin();
+            uint16_t captured = mcp->getCapturedInterrupt();
+            if ( intPin < 8 ) {
+                pinStates = (pinStates & 0xFF00) | (captured & 0x00FF);
+            } else if ( intPin < 16 ) {
+                pinStates = (pinStates & 0x00FF) | (captured & 0xFF00);
+            }
+            readPending = true;
+        } else if ( readPending ) {
+            pinStates = mcp->readGPIOAB();
+            readPending = false;
+        }
+        changedPins = previous ^ pinStates;
+    }
+
+    /**
+     * @brief Only read the pins when the MCP23017's INT line is asserted rather than on every update().
+     * 
+     * @details Call after begin(). Attached pins (before or after this call) are set to interrupt on change. INTA and
+     * INTB are mirrored so either can be connected to intPin. INT is active LOW and push-pull.
+     * 
+     * When INT is asserted, update() reads the interrupt flags and the capture register of the port that interrupted
+     * (its pins at the moment of the first change) and the next update() reads all of the pins again, so a quick
+     * change (eg an encoder edge) between updates is not lost. If both ports interrupt between updates, only port A's
+     * capture is used and port B's pins are read on the next update().
+     * Requires v2.3.0 or later of Adafruit's MCP23017 library.
+     * 
+     * @param intPin The MCU pin connected to INTA or INTB. Must support interrupts.
+     * @return true Interrupt mode is enabled
+     * @return false intPin has no interrupt or ExpanderInterrupt::MAX_INTERRUPTS are in use (the pins will still be read on every update())
+     */
+    bool enableInterrupt(byte intPin) {
+        if ( !interrupt.attach(intPin, LOW, INPUT) ) return false;
+        mcp->setupInterrupts(true, false, LOW);
+        for (byte pin = 0; pin < 16; pin++) {
+            if ( bitRead(inputPins, pin) ) mcp->setupInterruptPin(pin, CHANGE);
+        }
+        pinStates = mcp->readGPIOAB(); // Also clears any pending interrupt
+        readPending = false;
+        return true;
+    }
+
+    /**
+     * @brief Go back to reading the pins on every update().
+     */
+    void disableInterrupt() {
+        if ( !interrupt.isAttached() ) return;
+        interrupt.detach();
+        for (byte pin = 0; pin < 16; pin++) {
+            if ( bitRead(inputPins, pin) ) mcp->disableInterruptPin(pin);
+        }
     }
 
+    /**
+     * @brief Returns true if enableInterrupt() has succeeded.
+     */
+    bool isInterruptEnabled() { return interrupt.isAttached(); }
+
     /**
      * @brief Attach a pin and set its pin mode
      * 
@@ -84,6 +150,9 @@ public:
      */
     void attachPin(byte pin, int mode = INPUT_PULLUP) override {
           mcp->pinMode(pin, mode);
+          if ( mode == OUTPUT ) return;
+          bitSet(inputPins, pin);
+          if ( interrupt.isAttached() ) mcp->setupInterruptPin(pin, CHANGE);
     }
 
     /**
@@ -98,6 +167,20 @@ public:
         return bitRead(pinStates, pin);
     }
 
+    /**
+     * @brief Returns the state of all pins from the last update(), one bit per pin.
+     */
+    uint32_t readAll() override {
+        return pinStates;
+    }
+
+    /**
+     * @brief Returns the pins that changed on the last update().
+     */
+    uint32_t changedMask() override {
+        return changedPins;
+    }
+
     /**
      * @brief Update the expander over I2C and return a pin state. Not recommended, use a single uptate() and then multiple pin read()s in loop().
      * 
@@ -135,6 +218,10 @@ public:
     alignas(Adafruit_MCP23X17) uint8_t mcpStorage[sizeof(Adafruit_MCP23X17)]; ///< Used with placement new to avoid heap allocation.
     Adafruit_MCP23X17* mcp;
     uint16_t pinStates = 0;
+    uint16_t changedPins = 0;
+    uint16_t inputPins = 0; ///< Attached input pins (set to interrupt on change by enableInterrupt())
+    ExpanderInterrupt interrupt;
+    bool readPending = false; ///< INTCAP was read on the last update() so read the pins on the next
 };
 
 
@@ -5,6 +5,7 @@
 #include <new>
 #include <Adafruit_PCF8574.h>
 #include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/ExpanderInterrupt.h"
 #include "PinAdapter/PinAdapter.h"
 
 /**
@@ -12,6 +13,9 @@
  *
  * Details: https://learn.adafruit.com/adafruit-pcf8574
  * 
+ * By default every update() reads the pins over I2C. With enableInterrupt() the pins are only read when the PCF's
+ * INT line is asserted, plus an occasional refresh read.
+ * 
  */
 class AdafruitPCF8574ExpanderAdapter : public GpioExpanderAdapter {
 
@@ -71,9 +75,44 @@ public:
      * 
      */
     void update() override {
+        if ( interrupt.isAttached() && !interrupt.takeReadDue() ) {
+            changedPins = 0; // Nothing has changed since the last read
+            return;
+        }
+        uint8_t previous = pinStates;
         pinStates = pcf->digitalReadByte();
+        changedPins = previous ^ pinStates;
     }
 
+    /**
+     * @brief Only read the pins when the PCF8574's INT line is asserted (or the refresh interval has passed) rather than on every update().
+     * 
+     * @details Call after begin(). INT is open drain and active LOW - intPin is set to INPUT_PULLUP but a 10k external
+     * pull-up is better on a long line or if several INT lines are wired together. The refresh read catches any change
+     * missed while the pins were being read.
+     * 
+     * @param intPin The MCU pin connected to INT. Must support interrupts.
+     * @param refreshMs The maximum interval between reads if INT is not asserted (default 1000ms, 0 for never)
+     * @return true Interrupt mode is enabled
+     * @return false intPin has no interrupt or ExpanderInterrupt::MAX_INTERRUPTS are in use (the pins will still be read on every update())
+     */
+    bool enableInterrupt(byte intPin, uint16_t refreshMs = 1000) {
+        if ( !interrupt.attach(intPin, LOW, INPUT_PULLUP) ) return false;
+        interrupt.setRefreshInterval(refreshMs);
+        pinStates = pcf->digitalReadByte(); // Also clears INT
+        return true;
+    }
+
+    /**
+     * @brief Go back to reading the pins on every update().
+     */
+    void disableInterrupt() { interrupt.detach(); }
+
+    /**
+     * @brief Returns true if enableInterrupt() has succeeded.
+     */
+    bool isInterruptEnabled() { return interrupt.isAttached(); }
+
     /**
      * @brief Attach a pin and set its pin mode
      * 
@@ -96,6 +135,20 @@ public:
         return bitRead(pinStates, pin);
     }
 
+    /**
+     * @brief Returns the state of all pins from the last update(), one bit per pin.
+     */
+    uint32_t readAll() override {
+        return pinStates;
+    }
+
+    /**
+     * @brief Returns the pins that changed on the last update().
+     */
+    uint32_t changedMask() override {
+        return changedPins;
+    }
+
     /**
      * @brief Update the expander over I2C and return a pin state. Not recommended, use a single uptate() and then multiple pin read()s in loop().
      * 
@@ -133,6 +186,8 @@ private:
     alignas(Adafruit_PCF8574) uint8_t pcfStorage[sizeof(Adafruit_PCF8574)]; ///< Used with placement new to avoid heap allocation.
     Adafruit_PCF8574* pcf;
     uint8_t pinStates = 0;
+    uint8_t changedPins = 0;
+    ExpanderInterrupt interrupt;
 };
 
 
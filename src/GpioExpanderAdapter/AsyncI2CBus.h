@@ -0,0 +1,75 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_ASYNC_I2C_BUS_H
+#define INPUT_EVENTS_ASYNC_I2C_BUS_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The interface of an I2C bus that reads without blocking, used by AsyncI2CExpanderAdapter.
+ *
+ * @details startRead() starts a transfer and returns straight away. The transfer then runs (by interrupt or DMA) while
+ * status() is BUSY, and takeData() collects the bytes once it is DONE (or clears a FAILED transfer), freeing the bus.
+ * Only one transfer is in progress at a time, so several expanders on one bus take turns.
+ *
+ * The library does not include a non-blocking implementation - this is only the interface. Implement it for a core
+ * with an interrupt or DMA driven I2C API (eg the STM32 HAL's HAL_I2C_Master_Receive_IT() or the Teensy 4 LPI2C
+ * driver). WireAsyncI2CBus is a blocking fallback that works on every board, but as the whole transfer happens in
+ * startRead() it gives none of the benefit.
+ */
+class AsyncI2CBus {
+
+public:
+
+    static constexpr int16_t NO_REGISTER = -1; ///< Read without writing a register address first (eg PCF8574/PCF8575)
+    static constexpr uint8_t MAX_LENGTH = 4; ///< The maximum bytes in one read
+
+    /**
+     * @brief The state of the current (or last) transfer.
+     */
+    enum class Status : uint8_t {
+        IDLE,   ///< The bus is free
+        BUSY,   ///< A transfer is in progress
+        DONE,   ///< A transfer has completed - call takeData()
+        FAILED  ///< A transfer failed (eg no ACK) - call takeData() to free the bus
+    };
+
+    /**
+     * @brief Initialise the bus. (Idempotent)
+     */
+    virtual void begin() {}
+
+    /**
+     * @brief Start reading from a device.
+     *
+     * @param address The 7 bit I2C address
+     * @param length The number of bytes to read (1 to MAX_LENGTH)
+     * @param reg The register to read from (written before the read with a repeated start) or NO_REGISTER
+     * @return true The transfer has started
+     * @return false The bus is not IDLE
+     */
+    virtual bool startRead(uint8_t address, uint8_t length, int16_t reg = NO_REGISTER) = 0;
+
+    /**
+     * @brief The state of the current (or last) transfer.
+     */
+    virtual Status status() = 0;
+
+    /**
+     * @brief Copy the bytes of a DONE transfer (first byte received first) and free the bus.
+     *
+     * @param buffer At least the length passed to startRead()
+     * @return uint8_t The number of bytes copied (0 if the transfer FAILED)
+     */
+    virtual uint8_t takeData(uint8_t* buffer) = 0;
+
+    virtual ~AsyncI2CBus() = default;
+};
+
+#endif
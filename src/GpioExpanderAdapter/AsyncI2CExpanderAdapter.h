@@ -0,0 +1,164 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_ASYNC_I2C_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_ASYNC_I2C_EXPANDER_ADAPTER_H
+
+#include <Arduino.h>
+#include "InputEventsClock.h"
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/AsyncI2CBus.h"
+
+/**
+ * @brief A GpioExpanderAdapter that reads an I2C expander without blocking update().
+ *
+ * @details update() starts a read and a later update() collects the result once the transfer has completed, so the
+ * loop is not stalled by the transfer - provided the AsyncI2CBus really is non-blocking. The library only includes
+ * the blocking WireAsyncI2CBus, so this needs a bus implemented for your board. The pin states are therefore from the last completed read -
+ * sampleTimeMs() is the time that read was started and sampleAgeMs() how long ago that was.
+ *
+ * The adapter only reads the expander. The pins must already be inputs: PCF8574/PCF8575 pins are inputs (pulled up)
+ * at power on, an MCP23017 must be set up first (eg with Adafruit's library) and read from MCP23017_GPIO.
+ * ```
+ * WireAsyncI2CBus bus; // Or an AsyncI2CBus for your board
+ * AsyncI2CExpanderAdapter expander(bus, 0x20, 16);
+ * EventButton button(new ExpanderPinAdapter(0, expander));
+ * ```
+ * Several adapters can share one bus - they take turns.
+ */
+class AsyncI2CExpanderAdapter : public GpioExpanderAdapter {
+
+public:
+
+    static constexpr int16_t MCP23017_GPIO = 0x12; ///< The MCP23017 GPIOA register (followed by GPIOB)
+
+    /**
+     * @brief Construct an AsyncI2CExpanderAdapter
+     *
+     * @param bus The bus the expander is on
+     * @param address The I2C address of the expander
+     * @param pinCount The number of pins (8 for a PCF8574, 16 for a PCF8575 or MCP23017, up to 32)
+     * @param reg The register to read, or AsyncI2CBus::NO_REGISTER (the default) for expanders without registers (eg PCF857x)
+     */
+    AsyncI2CExpanderAdapter(AsyncI2CBus& bus, uint8_t address = 0x20, uint8_t pinCount = 16, int16_t reg = AsyncI2CBus::NO_REGISTER)
+        : bus(&bus),
+          address(address),
+          length(pinCount > 32 ? 4 : (pinCount + 7) / 8),
+          reg(reg)
+        {}
+
+    /**
+     * @brief Begin the bus and wait (up to 10ms) for a first read of the pins.
+     */
+    void begin() override {
+        bus->begin();
+        for (uint8_t i = 0; i < 200 && !sampled; i++) {
+            if ( !reading ) startRead();
+            collect();
+            if ( !sampled ) delayMicroseconds(50);
+        }
+        changedPins = 0;
+    }
+
+    /**
+     * @brief Collect the last read if it has completed, otherwise start the next.
+     *
+     * @details A read is not started on the same update() as a collect so other adapters on the bus get a turn.
+     */
+    void update() override {
+        changedPins = 0;
+        if ( reading ) {
+            collect();
+        } else if ( startRead() ) {
+            collect(); // A blocking bus has already finished
+        }
+    }
+
+    bool read(byte pin) override { return bitRead(pinStates, pin); }
+
+    /**
+     * @brief The expander pins are not configured by this adapter.
+     */
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+
+    /**
+     * @brief Returns the state of all pins from the last completed read, one bit per pin.
+     */
+    uint32_t readAll() override { return pinStates; }
+
+    /**
+     * @brief Returns the pins that changed on the last update(). Zero if no read completed.
+     */
+    uint32_t changedMask() override { return changedPins; }
+
+    /**
+     * @brief The time at which the last completed read was started.
+     */
+    uint32_t sampleTimeMs() { return sampleMs; }
+
+    /**
+     * @brief How long ago the last completed read was started.
+     */
+    uint32_t sampleAgeMs() override { return InputEventsClock::now() - sampleMs; }
+
+    /**
+     * @brief Returns true if a read has completed since begin().
+     */
+    bool hasSample() { return sampled; }
+
+    /**
+     * @brief The number of reads that have failed (eg the expander did not respond).
+     */
+    uint16_t failedReads() { return failures; }
+
+private:
+    AsyncI2CBus* bus;
+    uint8_t address;
+    uint8_t length;
+    int16_t reg;
+    bool reading = false;
+    bool sampled = false;
+    uint32_t pinStates = 0;
+    uint32_t changedPins = 0;
+    uint32_t startMs = 0;
+    uint32_t sampleMs = 0;
+    uint16_t failures = 0;
+
+    /**
+     * @brief Start a read if the bus is free.
+     */
+    bool startRead() {
+        if ( !bus->startRead(address, length, reg) ) return false;
+        reading = true;
+        startMs = InputEventsClock::now();
+        return true;
+    }
+
+    /**
+     * @brief Take the data of a finished read.
+     */
+    void collect() {
+        if ( !reading || bus->status() == AsyncI2CBus::Status::BUSY ) return;
+        reading = false;
+        uint8_t data[AsyncI2CBus::MAX_LENGTH];
+        if ( bus->takeData(data) != length ) {
+            failures++;
+            return;
+        }
+        uint32_t pins = 0;
+        for (uint8_t i = 0; i < length; i++) {
+            pins |= (uint32_t)data[i] << (8 * i);
+        }
+        changedPins |= pins ^ pinStates;
+        pinStates = pins;
+        sampleMs = startMs;
+        sampled = true;
+    }
+};
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_DEBOUNCED_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_DEBOUNCED_EXPANDER_ADAPTER_H
+
+#include "Arduino.h"
+#include "InputEventsClock.h"
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/VerticalCounterDebouncer.h"
+
+/**
+ * @brief A GpioExpanderAdapter that debounces all of the pins of another GpioExpanderAdapter in one go.
+ *
+ * @details Wrap any expander adapter (eg HC165ExpanderAdapter or AdafruitMCP23017ExpanderAdapter) and pass the
+ * DebouncedExpanderAdapter to your ExpanderPinAdapters. The pins are sampled every sampleIntervalMs and debounced
+ * by a VerticalCounterDebouncer, so a change is accepted after four consecutive samples (9-12ms with the default
+ * 3ms interval).
+ *
+ * As the pins are already debounced, create the buttons and switches *without* a debouncer so there is no per-pin
+ * timing work:
+ * ```
+ * HC165ExpanderAdapter hc165(DATA_PIN, CLOCK_PIN, SHLD_PIN, 4); // 32 pins
+ * DebouncedExpanderAdapter expander(hc165); // Debounces all 32
+ * EventButton button(new ExpanderPinAdapter(0, expander), false);
+ * ```
+ * To ignore the unused pins of a smaller expander (eg an MCP23017), pass its pin count:
+ * ```
+ * DebouncedExpanderAdapter expander(mcp, 3, 16);
+ * ```
+ * Call the DebouncedExpanderAdapter's update() (not the wrapped adapter's) from <code>loop()</code>.
+ */
+class DebouncedExpanderAdapter : public GpioExpanderAdapter {
+
+public:
+
+    /**
+     * @brief Construct a DebouncedExpanderAdapter
+     *
+     * @param expander The expander adapter to debounce
+     * @param sampleIntervalMs The interval between samples (default 3ms). The debounce time is four intervals.
+     * @param pinCount The number of expander pins to debounce, from pin 0 (default and maximum 32). Higher pins read 0.
+     */
+    DebouncedExpanderAdapter(GpioExpanderAdapter& expander, uint8_t sampleIntervalMs = 3, uint8_t pinCount = 32)
+        : expander(&expander),
+          sampleIntervalMs(sampleIntervalMs),
+          pinCount(pinCount > 32 ? 32 : pinCount)
+        {}
+
+    void begin() override {
+        expander->begin();
+        expander->update(); // Not all expander adapters read their pins in begin()
+        lastSampleMs = InputEventsClock::now();
+        debouncer.begin(readPins());
+    }
+
+    /**
+     * @brief If a sample is due, update the wrapped expander and debounce its pins.
+     */
+    void update() override {
+        uint32_t now = InputEventsClock::now();
+        if ( now - lastSampleMs < sampleIntervalMs ) {
+            changedBits = 0;
+            return;
+        }
+        lastSampleMs = now;
+        expander->update();
+        debouncer.update(readPins());
+        changedBits = debouncer.changed();
+    }
+
+    /**
+     * @brief Returns the debounced state of a pin
+     */
+    bool read(byte pin) override {
+        return bitRead(debouncer.read(), pin);
+    }
+
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {
+        expander->attachPin(pin, mode);
+    }
+
+    /**
+     * @brief The debounced state of all pins, one bit per pin.
+     */
+    uint32_t readAll() override { return debouncer.read(); }
+
+    /**
+     * @brief The pins whose debounced state changed on the last update().
+     */
+    uint32_t changedMask() override { return changedBits; }
+
+    /**
+     * @brief The age of the wrapped expander's last sample (not including the debounce time).
+     */
+    uint32_t sampleAgeMs() override { return expander->sampleAgeMs(); }
+
+    /**
+     * @brief Returns true if any pin is part way through being debounced.
+     */
+    bool isSettling() { return debouncer.isSettling(); }
+
+    /**
+     * @brief Set the interval between samples. The debounce time is four intervals.
+     */
+    void setSampleInterval(uint8_t intervalMs) { sampleIntervalMs = intervalMs; }
+
+private:
+    GpioExpanderAdapter* expander;
+    VerticalCounterDebouncer<uint32_t> debouncer;
+    uint32_t lastSampleMs = 0;
+    uint32_t changedBits = 0;
+    uint8_t sampleIntervalMs;
+    uint8_t pinCount;
+
+    uint32_t readPins() {
+        uint32_t mask = pinCount >= 32 ? 0xFFFFFFFF : (1UL << pinCount) - 1;
+        return expander->readAll() & mask;
+    }
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "ExpanderBusScheduler.h"
+
+bool ExpanderBusScheduler::add(ScheduledExpanderAdapter& expander) {
+    ScheduledExpanderAdapter** link = &head;
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        if ( e == &expander ) return false;
+    }
+    // After any of the same priority so expanders are read in the order they were added
+    while ( *link && (*link)->priority >= expander.priority ) {
+        link = &(*link)->nextScheduled;
+    }
+    expander.nextScheduled = *link;
+    *link = &expander;
+    expander.nextReadMs = InputEventsClock::now();
+    return true;
+}
+
+bool ExpanderBusScheduler::remove(ScheduledExpanderAdapter& expander) {
+    for (ScheduledExpanderAdapter** link = &head; *link; link = &(*link)->nextScheduled) {
+        if ( *link != &expander ) continue;
+        *link = expander.nextScheduled;
+        expander.nextScheduled = nullptr;
+        return true;
+    }
+    return false;
+}
+
+void ExpanderBusScheduler::begin() {
+    uint32_t nowMs = InputEventsClock::now();
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        read(*e, nowMs);
+        e->pendingBits = 0; // Nothing has changed yet
+    }
+    resetStats();
+}
+
+uint8_t ExpanderBusScheduler::update() {
+    uint32_t nowMs = InputEventsClock::now();
+    uint32_t spentUs = 0;
+    uint8_t reads = 0;
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        if ( !InputEventsClock::hasReached(e->nextReadMs) ) continue;
+        if ( budgetUs && reads && spentUs >= budgetUs ) {
+            e->deferred++;
+            continue;
+        }
+        spentUs += read(*e, nowMs);
+        reads++;
+    }
+    return reads;
+}
+
+uint32_t ExpanderBusScheduler::read(ScheduledExpanderAdapter& e, uint32_t nowMs) {
+    uint32_t start = micros();
+    e.expander->update();
+    uint32_t us = micros() - start;
+    e.pendingBits |= e.expander->changedMask();
+    e.lastReadMs = nowMs;
+    // Keep to the interval unless a whole interval has been missed, then start again from now
+    if ( nowMs - e.nextReadMs >= e.intervalMs ) {
+        e.nextReadMs = nowMs + e.intervalMs;
+    } else {
+        e.nextReadMs += e.intervalMs;
+    }
+    e.samples++;
+    e.busUs += us;
+    if ( us > e.maxReadUs ) e.maxReadUs = us > 0xFFFF ? 0xFFFF : us;
+    busUs += us;
+    return us;
+}
+
+uint32_t ExpanderBusScheduler::nextReadMs() {
+    uint32_t nowMs = InputEventsClock::now();
+    uint32_t next = nowMs + 0x7FFFFFFF;
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        if ( InputEventsClock::isBefore(e->nextReadMs, next) ) next = e->nextReadMs;
+    }
+    return next;
+}
+
+void ExpanderBusScheduler::resetStats() {
+    statsStartMs = InputEventsClock::now();
+    busUs = 0;
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        e->samples = 0;
+        e->busUs = 0;
+        e->deferred = 0;
+        e->maxReadUs = 0;
+    }
+}
+
+float ExpanderBusScheduler::busUtilisation() {
+    uint32_t ms = statsMs();
+    if ( !ms ) return 0;
+    return (float)busUs / ((float)ms * 10.0f);
+}
+
+float ExpanderBusScheduler::sampleRate(ScheduledExpanderAdapter& expander) {
+    uint32_t ms = statsMs();
+    if ( !ms ) return 0;
+    return (float)expander.samples * 1000.0f / (float)ms;
+}
+
+uint8_t ExpanderBusScheduler::count() {
+    uint8_t n = 0;
+    for (ScheduledExpanderAdapter* e = head; e; e = e->nextScheduled) {
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,135 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_EXPANDER_BUS_SCHEDULER_H
+#define INPUT_EVENTS_EXPANDER_BUS_SCHEDULER_H
+
+#include <Arduino.h>
+#include "InputEventsClock.h"
+#include "GpioExpanderAdapter/ScheduledExpanderAdapter.h"
+
+/**
+ * @brief Reads the expanders on a shared bus (eg one TwoWire) at their own rates, back to back, and reports how much of
+ * the bus they use.
+ *
+ * @details Each expander is wrapped in a ScheduledExpanderAdapter with an interval and a priority (eg encoders every
+ * 1ms, switches every 20ms). update() reads every expander whose interval is due in one burst, highest priority first,
+ * so the rest of the loop (a display, sensors) has the bus to itself in between. nextReadMs() says when the next burst
+ * is due.
+ * ```
+ * ExpanderBusScheduler bus;
+ * AdafruitMCP23017ExpanderAdapter mcp;
+ * AdafruitPCF8575ExpanderAdapter pcf;
+ * ScheduledExpanderAdapter encoders(mcp, 1, 10);
+ * ScheduledExpanderAdapter switches(pcf, 20);
+ *
+ * void setup() {
+ *     mcp.begin(0x20);
+ *     pcf.begin(0x21);
+ *     bus.add(encoders);
+ *     bus.add(switches);
+ *     bus.begin();
+ * }
+ *
+ * void loop() {
+ *     bus.update();
+ *     inputs.update(); // or each input's update()
+ * }
+ * ```
+ * With setBudgetMicros(), a burst stops once that much time has been spent and the remaining (lower priority) reads
+ * are deferred to the next update().
+ *
+ * The statistics are from the last resetStats() (or begin()): busUtilisation() is the percentage of the time spent in
+ * the expanders' update() and sampleRate() the reads per second achieved by each expander. An adapter that reads
+ * without blocking (eg AsyncI2CExpanderAdapter) only reports the time taken to start and collect its transfers.
+ */
+class ExpanderBusScheduler {
+
+public:
+
+    /**
+     * @brief Add an expander. Expanders are read in priority order (highest first), then in the order they were added.
+     *
+     * @return false The expander was already added
+     */
+    bool add(ScheduledExpanderAdapter& expander);
+
+    /**
+     * @brief Remove an expander.
+     *
+     * @return true The expander had been added
+     */
+    bool remove(ScheduledExpanderAdapter& expander);
+
+    /**
+     * @brief Read every expander and reset the statistics.
+     *
+     * @details The expanders are not begun by the scheduler as some need arguments (eg an I2C address) - call their
+     * begin() first.
+     */
+    void begin();
+
+    /**
+     * @brief Read the expanders that are due, back to back.
+     *
+     * @return uint8_t The number of expanders read
+     */
+    uint8_t update();
+
+    /**
+     * @brief The time the next read is due (safe across millis() rollover - compare with InputEventsClock).
+     */
+    uint32_t nextReadMs();
+
+    /**
+     * @brief Limit the time spent reading in one update(). 0 (the default) reads every expander that is due.
+     *
+     * @details The highest priority expander that is due is always read.
+     */
+    void setBudgetMicros(uint16_t us) { budgetUs = us; }
+
+    /**
+     * @brief Reset the statistics of the scheduler and its expanders.
+     */
+    void resetStats();
+
+    /**
+     * @brief The percentage of the time since resetStats() spent reading the expanders.
+     */
+    float busUtilisation();
+
+    /**
+     * @brief The reads per second achieved by an expander since resetStats().
+     */
+    float sampleRate(ScheduledExpanderAdapter& expander);
+
+    /**
+     * @brief The total time in microseconds spent reading the expanders since resetStats().
+     */
+    uint32_t busMicros() { return busUs; }
+
+    /**
+     * @brief The milliseconds since resetStats().
+     */
+    uint32_t statsMs() { return InputEventsClock::now() - statsStartMs; }
+
+    /**
+     * @brief The number of expanders added.
+     */
+    uint8_t count();
+
+private:
+    ScheduledExpanderAdapter* head = nullptr;
+    uint32_t statsStartMs = 0;
+    uint32_t busUs = 0;
+    uint16_t budgetUs = 0;
+
+    uint32_t read(ScheduledExpanderAdapter& expander, uint32_t nowMs);
+};
+
+#endif
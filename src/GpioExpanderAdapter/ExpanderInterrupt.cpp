@@ -0,0 +1,60 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "ExpanderInterrupt.h"
+
+volatile bool ExpanderInterrupt::pending[MAX_INTERRUPTS] = {};
+bool ExpanderInterrupt::used[MAX_INTERRUPTS] = {};
+
+bool ExpanderInterrupt::attach(byte intPin, uint8_t level /*=LOW*/, uint8_t mode /*=INPUT_PULLUP*/) {
+    detach();
+    int irq = digitalPinToInterrupt(intPin);
+    #ifdef NOT_AN_INTERRUPT
+    if ( irq == NOT_AN_INTERRUPT ) return false;
+    #endif
+    uint8_t free = 0;
+    while ( free < MAX_INTERRUPTS && used[free] ) {
+        free++;
+    }
+    if ( free == MAX_INTERRUPTS ) return false;
+    static void (* const isrs[MAX_INTERRUPTS])() = { onInterrupt0, onInterrupt1, onInterrupt2, onInterrupt3 };
+    used[free] = true;
+    slot = free;
+    pin = intPin;
+    pending[slot] = false;
+    lastReadMs = InputEventsClock::now();
+    pinMode(pin, mode);
+    attachInterrupt(irq, isrs[slot], level == LOW ? FALLING : RISING);
+    return true;
+}
+
+void ExpanderInterrupt::detach() {
+    if ( !isAttached() ) return;
+    detachInterrupt(digitalPinToInterrupt(pin));
+    used[slot] = false;
+    pending[slot] = false;
+    slot = NO_SLOT;
+}
+
+bool ExpanderInterrupt::takePending() {
+    if ( !isAttached() ) return false;
+    noInterrupts();
+    bool wasPending = pending[slot];
+    pending[slot] = false;
+    interrupts();
+    return wasPending;
+}
+
+bool ExpanderInterrupt::takeReadDue() {
+    uint32_t now = InputEventsClock::now();
+    if ( takePending() || (refreshMs > 0 && now - lastReadMs >= refreshMs) ) {
+        lastReadMs = now;
+        return true;
+    }
+    return false;
+}
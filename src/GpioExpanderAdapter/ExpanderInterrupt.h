@@ -0,0 +1,91 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_EXPANDER_INTERRUPT_H
+#define INPUT_EVENTS_EXPANDER_INTERRUPT_H
+
+#include <Arduino.h>
+#include "InputEventsClock.h"
+
+/**
+ * @brief Watches the INT line of a GPIO expander with an MCU interrupt.
+ *
+ * @details The interrupt only sets a flag - the expander is read by the adapter's update() when the flag is set, so
+ * there is no I2C in the ISR. The interrupt is on the edge that asserts INT, so the adapter must clear INT (by reading
+ * the expander) when it sees the flag. Up to MAX_INTERRUPTS expanders can be watched (the ISRs are static trampolines as
+ * <code>attachInterrupt()</code> does not take a context on most boards).
+ *
+ * An optional refresh interval (see takeReadDue()) reads the expander now and then even if INT has not been asserted,
+ * in case a change was missed (eg the PCF857x can drop INT during a read).
+ *
+ * Used by expander adapters with an interrupt mode, eg AdafruitMCP23017ExpanderAdapter::enableInterrupt().
+ */
+class ExpanderInterrupt {
+
+public:
+
+    static constexpr uint8_t MAX_INTERRUPTS = 4; ///< The number of INT lines that can be watched
+
+    /**
+     * @brief Attach an interrupt to the MCU pin connected to the expander's INT line.
+     *
+     * @param pin The MCU pin (must support interrupts, see <code>digitalPinToInterrupt()</code>)
+     * @param activeLevel The level of the INT line when asserted (LOW for the MCP23017 and PCF857x)
+     * @param mode The MCU pin mode (default INPUT_PULLUP for open drain INT lines)
+     * @return true The interrupt is attached
+     * @return false The pin has no interrupt or MAX_INTERRUPTS are already attached
+     */
+    bool attach(byte pin, uint8_t activeLevel = LOW, uint8_t mode = INPUT_PULLUP);
+
+    /**
+     * @brief Detach the interrupt.
+     */
+    void detach();
+
+    /**
+     * @brief Returns true if the interrupt is attached.
+     */
+    bool isAttached() { return slot != NO_SLOT; }
+
+    /**
+     * @brief Returns true (and clears the flag) if the INT line has been asserted since the last call.
+     */
+    bool takePending();
+
+    /**
+     * @brief Set the interval at which takeReadDue() returns true without INT being asserted. Default is 0 (never).
+     */
+    void setRefreshInterval(uint16_t intervalMs) { refreshMs = intervalMs; }
+
+    /**
+     * @brief Returns true (and clears the flag) if the INT line has been asserted or the refresh interval has passed
+     * since this last returned true.
+     */
+    bool takeReadDue();
+
+    /**
+     * @brief The MCU pin.
+     */
+    byte getPin() { return pin; }
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+    static volatile bool pending[MAX_INTERRUPTS];
+    static bool used[MAX_INTERRUPTS];
+    static void onInterrupt0() { pending[0] = true; }
+    static void onInterrupt1() { pending[1] = true; }
+    static void onInterrupt2() { pending[2] = true; }
+    static void onInterrupt3() { pending[3] = true; }
+
+    uint8_t slot = NO_SLOT;
+    byte pin = 0;
+    uint16_t refreshMs = 0;
+    uint32_t lastReadMs = 0;
+};
+
+#endif
@@ -32,6 +32,45 @@ class GpioExpanderAdapter {
      */
     virtual bool read(byte pin) = 0;
 
+    /**
+     * @brief Returns the state of all pins from the last update(), one bit per pin (bit 0 is pin 0).
+     *
+     * @details The default implementation calls read() for each of the first 32 pins. Expander adapters that
+     * hold their pins in a word should override this.
+     */
+    virtual uint32_t readAll() {
+        uint32_t pins = 0;
+        for (byte pin = 0; pin < 32; pin++) {
+            if ( read(pin) ) pins |= (1UL << pin);
+        }
+        return pins;
+    }
+
+    /**
+     * @brief Returns the pins that changed on the last update(), one bit per pin.
+     *
+     * @details If this is zero, nothing attached to the expander needs to read its pin. The default implementation
+     * returns all bits set, ie 'any pin may have changed'.
+     */
+    virtual uint32_t changedMask() { return 0xFFFFFFFF; }
+
+    /**
+     * @brief Returns true if a pin changed on the last update() (or may have).
+     *
+     * @details The default implementation uses changedMask(), so pins above 31 are always reported as changed.
+     * Expander adapters with more than 32 pins should override this.
+     */
+    virtual bool pinChanged(byte pin) { return pin >= 32 || bitRead(changedMask(), pin); }
+
+    /**
+     * @brief The age in milliseconds of the pin states returned by read() and readAll().
+     *
+     * @details Adapters that read the expander in update() return 0. Adapters that read in the background (eg
+     * AsyncI2CExpanderAdapter) return the time since the pins were sampled, so an input can allow for (or ignore)
+     * stale states.
+     */
+    virtual uint32_t sampleAgeMs() { return 0; }
+
     /** @brief Use it to configure individual pin mode, if expander allows it.
      * Not all of them do.
      */
@@ -0,0 +1,192 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HC165_CASCADE_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_HC165_CASCADE_EXPANDER_ADAPTER_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/HC165ShiftIn.h"
+
+/**
+ * @brief A GpioExpanderAdapter for a cascade of any number of 74HC165 shift registers (up to 32 - 256 pins).
+ *
+ * @details The cascade length is a template parameter so the pin states are held in a fixed array of 32 bit words
+ * (pin 0 is bit 0 of word 0, pin 32 is bit 0 of word 1) and the pins that changed are found a word at a time.
+ * update() reads the cascade a byte (one 74HC165) at a time, either with hardware SPI (QH to MISO, CLK to SCK, see
+ * HC165SPIExpanderAdapter) or by shifting the bits in on two pins with an HC165ShiftIn (same wiring as
+ * HC165ExpanderAdapter).
+ * ```
+ * HC165CascadeExpanderAdapter<12> keys(DATA_PIN, CLOCK_PIN, SHLD_PIN); // 96 pins, shifted in
+ * HC165CascadeExpanderAdapter<12> keys(SHLD_PIN, SPI);                 // 96 pins, with SPI
+ * EventButton key(new ExpanderPinAdapter(95, keys));
+ * ```
+ * readAll() and changedMask() are the first 32 pins - use readWord(), changedWord() or nextChanged() for the rest.
+ *
+ * @tparam CHIPS The number of 74HC165s in the cascade (1-32)
+ */
+template <uint8_t CHIPS>
+class HC165CascadeExpanderAdapter : public GpioExpanderAdapter {
+
+    static_assert(CHIPS >= 1 && CHIPS <= 32, "A cascade is 1 to 32 74HC165s");
+
+public:
+
+    static constexpr uint16_t PIN_COUNT = CHIPS * 8; ///< The number of pins
+    static constexpr uint8_t WORD_COUNT = (CHIPS + 3) / 4; ///< The number of 32 bit words of pins
+
+    /**
+     * @brief Construct an HC165CascadeExpanderAdapter that shifts the bits in on two pins.
+     *
+     * @param dataPin Serial data (QH)
+     * @param clockPin Used to shift to next bit
+     * @param shldPin Shift/Load input
+     */
+    HC165CascadeExpanderAdapter(byte dataPin, byte clockPin, byte shldPin)
+        : dataPin(dataPin),
+          clockPin(clockPin),
+          shldPin(shldPin)
+        {}
+
+    /**
+     * @brief Construct an HC165CascadeExpanderAdapter that reads with hardware SPI.
+     *
+     * @param shldPin Shift/Load input
+     * @param spi The SPI bus, QH to MISO and CLK to SCK
+     * @param clockHz The SPI clock (default 4MHz)
+     */
+    HC165CascadeExpanderAdapter(byte shldPin, SPIClass& spi, uint32_t clockHz = 4000000)
+        : spi(&spi),
+          clockHz(clockHz),
+          shldPin(shldPin)
+        {}
+
+    void begin() override {
+        pinMode(shldPin, OUTPUT);
+        digitalWrite(shldPin, HIGH);
+        if ( spi ) {
+            spi->begin();
+        } else {
+            shiftIn.begin(dataPin, clockPin);
+        }
+    }
+
+    /**
+     * @brief Load the parallel inputs, read the cascade and find the pins that changed.
+     */
+    void update() override {
+        uint8_t bytes[CHIPS];
+        readBytes(bytes);
+        anyChanged = 0;
+        for (uint8_t w = 0; w < WORD_COUNT; w++) {
+            uint32_t word = 0;
+            for (uint8_t b = 0; b < 4 && w * 4 + b < CHIPS; b++) {
+                word |= (uint32_t)bytes[w * 4 + b] << (8 * b);
+            }
+            changed[w] = pins[w] ^ word;
+            anyChanged |= changed[w];
+            pins[w] = word;
+        }
+    }
+
+    bool read(byte pin) override {
+        return pin < PIN_COUNT && bitRead(pins[pin >> 5], pin & 31);
+    }
+
+    /**
+     * @brief Pins 0-31, see readWord().
+     */
+    uint32_t readAll() override { return pins[0]; }
+
+    /**
+     * @brief The pins of 0-31 that changed on the last update(), see changedWord().
+     */
+    uint32_t changedMask() override { return changed[0]; }
+
+    bool pinChanged(byte pin) override {
+        return pin < PIN_COUNT && bitRead(changed[pin >> 5], pin & 31);
+    }
+
+    /**
+     * @brief  pinMode not supported by 74HC165 so do nothing
+     */
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+
+    /**
+     * @brief The states of 32 pins, word 0 is pins 0-31, word 1 is pins 32-63 etc.
+     */
+    uint32_t readWord(uint8_t word) { return word < WORD_COUNT ? pins[word] : 0; }
+
+    /**
+     * @brief The pins of a word that changed on the last update().
+     */
+    uint32_t changedWord(uint8_t word) { return word < WORD_COUNT ? changed[word] : 0; }
+
+    /**
+     * @brief Returns true if any pin changed on the last update().
+     */
+    bool hasChanged() { return anyChanged != 0; }
+
+    /**
+     * @brief The first pin at or after from that changed on the last update(), or PIN_COUNT if there are none.
+     *
+     * @details To visit every changed pin:
+     * ```
+     * for (uint16_t pin = keys.nextChanged(0); pin < keys.PIN_COUNT; pin = keys.nextChanged(pin + 1)) { ... }
+     * ```
+     */
+    uint16_t nextChanged(uint16_t from) {
+        if ( !anyChanged ) return PIN_COUNT;
+        for (uint8_t w = from >> 5; w < WORD_COUNT; w++) {
+            uint32_t bits = changed[w];
+            if ( w == (from >> 5) ) bits &= 0xFFFFFFFF << (from & 31);
+            if ( bits ) return w * 32 + __builtin_ctzl(bits);
+        }
+        return PIN_COUNT;
+    }
+
+    /**
+     * @brief Copy the pin states of the last update(), one byte per 74HC165 (pin 0 is bit 0 of the first byte).
+     *
+     * @param buffer At least CHIPS bytes
+     */
+    void copyBytes(uint8_t* buffer) {
+        for (uint8_t i = 0; i < CHIPS; i++) {
+            buffer[i] = (uint8_t)(pins[i >> 2] >> (8 * (i & 3)));
+        }
+    }
+
+private:
+    SPIClass* spi = nullptr;
+    uint32_t clockHz = 0;
+    byte dataPin = 0;
+    byte clockPin = 0;
+    byte shldPin;
+    HC165ShiftIn shiftIn;
+    uint32_t pins[WORD_COUNT] = {};
+    uint32_t changed[WORD_COUNT] = {};
+    uint32_t anyChanged = 0;
+
+    void readBytes(uint8_t* bytes) {
+        digitalWrite(shldPin, LOW);
+        digitalWrite(shldPin, HIGH);
+        if ( spi ) {
+            memset(bytes, 0xFF, CHIPS);
+            spi->beginTransaction(SPISettings(clockHz, LSBFIRST, SPI_MODE0));
+            spi->transfer(bytes, CHIPS);
+            spi->endTransaction();
+        } else {
+            for (uint8_t i = 0; i < CHIPS; i++) {
+                bytes[i] = shiftIn.readByte();
+            }
+        }
+    }
+};
+
+#endif
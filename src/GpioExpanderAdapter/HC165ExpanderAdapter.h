@@ -53,6 +53,7 @@ class HC165ExpanderAdapter : public GpioExpanderAdapter {
      *
      */
     void update() override {
+        uint32_t previous = pins;
         // Step 1: Sample
         digitalWrite(shldPin, LOW);
         digitalWrite(shldPin, HIGH);
@@ -69,6 +70,7 @@ class HC165ExpanderAdapter : public GpioExpanderAdapter {
             digitalWrite(clockPin, HIGH);
             digitalWrite(clockPin, LOW);
         }
+        changedPins = previous ^ pins;
     }
 
     /**
@@ -81,6 +83,20 @@ class HC165ExpanderAdapter : public GpioExpanderAdapter {
         return bitRead(pins, pin);
     }
 
+    /**
+     * @brief Returns the state of all pins from the last update(), one bit per pin.
+     */
+    uint32_t readAll() override {
+        return pins;
+    }
+
+    /**
+     * @brief Returns the pins that changed on the last update().
+     */
+    uint32_t changedMask() override {
+        return changedPins;
+    }
+
     /**
      * @brief  pinMode not supported by 74HC165 so do nothing
      * 
@@ -97,6 +113,7 @@ class HC165ExpanderAdapter : public GpioExpanderAdapter {
     byte shldPin;
     int cascadeLength;
     uint32_t pins = 0;
+    uint32_t changedPins = 0;
 };
 
 #endif
\ No newline at end of file
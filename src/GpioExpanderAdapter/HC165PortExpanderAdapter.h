@@ -0,0 +1,96 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HC165_PORT_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_HC165_PORT_EXPANDER_ADAPTER_H
+
+#include <Arduino.h>
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+#include "GpioExpanderAdapter/HC165ShiftIn.h"
+
+/**
+ * @brief A GpioExpanderAdapter for a cascade of 74HC165 shift registers that shifts the bits in by writing and reading
+ * the port registers directly.
+ *
+ * @details A drop in replacement for HC165ExpanderAdapter (same wiring, same pins) for when the SPI bus is not free
+ * (otherwise see HC165SPIExpanderAdapter). The bits are shifted in by an HC165ShiftIn, which looks up the port
+ * registers of the data and clock pins once in begin() so each bit is a register read and two register writes rather
+ * than a digitalRead() and two digitalWrite()s. Cores that do not provide portInputRegister() and portOutputRegister()
+ * fall back to digitalRead()/digitalWrite().
+ */
+class HC165PortExpanderAdapter : public GpioExpanderAdapter {
+    static const uint8_t cascadeMaxLength = 4; // max number of 74HC165 supported by this implementation
+  public:
+
+    /**
+     * @brief Construct a new HC165PortExpanderAdapter
+     *
+     * @param dataPin Serial data
+     * @param clockPin Used to shift to next bit
+     * @param shldPin Shift/Load input
+     * @param cascadeLength The number of 74HC165s chained together (1-4, default is 1)
+     */
+    HC165PortExpanderAdapter(byte dataPin, byte clockPin, byte shldPin, byte cascadeLength = 1)
+        : dataPin(dataPin),
+          clockPin(clockPin),
+          shldPin(shldPin),
+          cascadeLength(cascadeLength < 1 ? 1 : (cascadeLength > cascadeMaxLength ? cascadeMaxLength : cascadeLength))
+        {}
+
+    /**
+     * @brief Initialize the pins and look up their port registers.
+     */
+    void begin() override {
+        pinMode(shldPin, OUTPUT);
+        digitalWrite(shldPin, HIGH);
+        shiftIn.begin(dataPin, clockPin);
+    }
+
+    /**
+     * @brief Load the parallel inputs and shift in the cascade.
+     */
+    void update() override {
+        uint32_t previous = pins;
+        digitalWrite(shldPin, LOW);
+        digitalWrite(shldPin, HIGH);
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < cascadeLength; i++) {
+            value |= (uint32_t)shiftIn.readByte() << (8 * i);
+        }
+        pins = value;
+        changedPins = previous ^ pins;
+    }
+
+    bool read(byte pin) override {
+        return bitRead(pins, pin);
+    }
+
+    uint32_t readAll() override {
+        return pins;
+    }
+
+    uint32_t changedMask() override {
+        return changedPins;
+    }
+
+    /**
+     * @brief  pinMode not supported by 74HC165 so do nothing
+     */
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+
+  private:
+    byte dataPin;
+    byte clockPin;
+    byte shldPin;
+    uint8_t cascadeLength;
+    uint32_t pins = 0;
+    uint32_t changedPins = 0;
+    HC165ShiftIn shiftIn;
+};
+
+#endif
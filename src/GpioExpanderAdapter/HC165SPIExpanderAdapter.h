@@ -0,0 +1,104 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HC165_SPI_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_HC165_SPI_EXPANDER_ADAPTER_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+
+/**
+ * @brief A GpioExpanderAdapter for a cascade of 74HC165 shift registers read with hardware SPI.
+ *
+ * @details The same wiring as HC165ExpanderAdapter except that QH goes to the SPI MISO pin and CLK to SCK (CLK INH
+ * to GND). update() pulses SH/LD and then clocks the whole cascade in with a single buffer transfer - one byte per
+ * 74HC165 - instead of a digitalRead() and two digitalWrite()s per bit. Cores that implement the buffer transfer with
+ * DMA or a FIFO (eg ESP32, RP2040, STM32) will use it.
+ *
+ * The pin numbering is the same as HC165ExpanderAdapter: pin 0 is pin H of the first 74HC165, pin 8 is pin H of the
+ * second and so on.
+ * ```
+ * HC165SPIExpanderAdapter expander(SHLD_PIN, 4); // Four 74HC165s on the default SPI
+ * ```
+ * The 74HC165's QH is not tri-stated, so if other devices share MISO, put a buffer (eg a 74HC125 enabled by SH/LD's
+ * inverse or a spare chip select) between QH and MISO.
+ */
+class HC165SPIExpanderAdapter : public GpioExpanderAdapter {
+    static const uint8_t cascadeMaxLength = 4; // max number of 74HC165 supported by this implementation
+  public:
+
+    /**
+     * @brief Construct a new HC165SPIExpanderAdapter
+     *
+     * @param shldPin Shift/Load input
+     * @param cascadeLength The number of 74HC165s chained together (1-4, default is 1)
+     * @param spi The SPI bus (default SPI)
+     * @param clockHz The SPI clock (default 4MHz, a 74HC165 at 5V is good for well over 20MHz)
+     */
+    HC165SPIExpanderAdapter(byte shldPin, byte cascadeLength = 1, SPIClass& spi = SPI, uint32_t clockHz = 4000000)
+        : spi(&spi),
+          clockHz(clockHz),
+          shldPin(shldPin),
+          cascadeLength(cascadeLength < 1 ? 1 : (cascadeLength > cascadeMaxLength ? cascadeMaxLength : cascadeLength))
+        {}
+
+    /**
+     * @brief Initialize SH/LD and the SPI bus.
+     */
+    void begin() override {
+        pinMode(shldPin, OUTPUT);
+        digitalWrite(shldPin, HIGH);
+        spi->begin();
+    }
+
+    /**
+     * @brief Load the parallel inputs and read the cascade.
+     */
+    void update() override {
+        uint32_t previous = pins;
+        uint8_t buffer[cascadeMaxLength] = { 0xFF, 0xFF, 0xFF, 0xFF };
+        digitalWrite(shldPin, LOW);
+        digitalWrite(shldPin, HIGH);
+        spi->beginTransaction(SPISettings(clockHz, LSBFIRST, SPI_MODE0));
+        spi->transfer(buffer, cascadeLength);
+        spi->endTransaction();
+        pins = 0;
+        for (uint8_t i = 0; i < cascadeLength; i++) {
+            pins |= (uint32_t)buffer[i] << (8 * i);
+        }
+        changedPins = previous ^ pins;
+    }
+
+    bool read(byte pin) override {
+        return bitRead(pins, pin);
+    }
+
+    uint32_t readAll() override {
+        return pins;
+    }
+
+    uint32_t changedMask() override {
+        return changedPins;
+    }
+
+    /**
+     * @brief  pinMode not supported by 74HC165 so do nothing
+     */
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override {}
+
+  private:
+    SPIClass* spi;
+    uint32_t clockHz;
+    byte shldPin;
+    uint8_t cascadeLength;
+    uint32_t pins = 0;
+    uint32_t changedPins = 0;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_HC165_SHIFT_IN_H
+#define INPUT_EVENTS_HC165_SHIFT_IN_H
+
+#include <Arduino.h>
+#include "InterruptLock.h"
+
+#if defined(portInputRegister) && defined(portOutputRegister) && defined(digitalPinToPort) && defined(digitalPinToBitMask)
+    #define INPUT_EVENTS_HC165_PORT_IO
+#endif
+
+/**
+ * @brief Shifts bytes in from a 74HC165 cascade, LSB (pin H) first, using the port registers when the core has them.
+ *
+ * @details The port registers and bit masks of the data and clock pins are looked up once in begin() so each bit is a
+ * register read and two register writes rather than a digitalRead() and two digitalWrite()s. Cores that do not provide
+ * portInputRegister() and portOutputRegister() (see INPUT_EVENTS_HC165_PORT_IO) fall back to digitalRead() and
+ * digitalWrite(). With the port registers, interrupts are disabled while each byte is shifted in (the clock port
+ * write is a read-modify-write, which an ISR writing to the same port could interleave with) and their previous
+ * state is then restored, so readByte() can be called from an interrupt or inside another critical section.
+ */
+class HC165ShiftIn {
+
+public:
+
+    /**
+     * @brief Set the pin modes and look up the port registers.
+     */
+    void begin(byte dataPin, byte clockPin) {
+        pinMode(dataPin, INPUT);
+        pinMode(clockPin, OUTPUT);
+        digitalWrite(clockPin, LOW);
+        #ifdef INPUT_EVENTS_HC165_PORT_IO
+        dataIn = portInputRegister(digitalPinToPort(dataPin));
+        dataMask = digitalPinToBitMask(dataPin);
+        clockOut = portOutputRegister(digitalPinToPort(clockPin));
+        clockMask = digitalPinToBitMask(clockPin);
+        #else
+        this->dataPin = dataPin;
+        this->clockPin = clockPin;
+        #endif
+    }
+
+    /**
+     * @brief Shift in the next eight bits. The first bit is bit 0.
+     */
+    uint8_t readByte() {
+        #ifdef INPUT_EVENTS_HC165_PORT_IO
+        InterruptLock lock; //Once per byte rather than per clock pulse
+        #endif
+        uint8_t value = 0;
+        for (uint8_t bit = 1; bit; bit <<= 1) {
+            if ( readData() ) value |= bit;
+            pulseClock();
+        }
+        return value;
+    }
+
+private:
+    #ifdef INPUT_EVENTS_HC165_PORT_IO
+    typedef decltype(portInputRegister(digitalPinToPort(0))) InputRegister;
+    typedef decltype(portOutputRegister(digitalPinToPort(0))) OutputRegister;
+    typedef decltype(digitalPinToBitMask(0)) PortMask;
+    InputRegister dataIn = nullptr;
+    OutputRegister clockOut = nullptr;
+    PortMask dataMask = 0;
+    PortMask clockMask = 0;
+
+    bool readData() { return (*dataIn & dataMask) != 0; }
+
+    void pulseClock() {
+        *clockOut |= clockMask;
+        *clockOut &= ~clockMask;
+    }
+    #else
+    byte dataPin = 0;
+    byte clockPin = 0;
+
+    bool readData() { return digitalRead(dataPin) == HIGH; }
+
+    void pulseClock() {
+        digitalWrite(clockPin, HIGH);
+        digitalWrite(clockPin, LOW);
+    }
+    #endif
+};
+
+#endif
@@ -0,0 +1,131 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_SCHEDULED_EXPANDER_ADAPTER_H
+#define INPUT_EVENTS_SCHEDULED_EXPANDER_ADAPTER_H
+
+#include <Arduino.h>
+#include "InputEventsClock.h"
+#include "GpioExpanderAdapter/GpioExpanderAdapter.h"
+
+/**
+ * @brief A GpioExpanderAdapter whose expander is read by an ExpanderBusScheduler at a set interval.
+ *
+ * @details Wrap each expander on a shared bus, add the wrappers to an ExpanderBusScheduler and pass the wrappers (not
+ * the expanders) to your ExpanderPinAdapters, ExpanderEncoderAdapters or ExpanderInputDispatcher. The scheduler reads
+ * the expander when its interval is due; this adapter's update() does not touch the bus, it only picks up the pins that
+ * changed on the scheduler's reads since the last update(), so changedMask() is zero between reads.
+ * ```
+ * ExpanderBusScheduler bus;
+ * AdafruitMCP23017ExpanderAdapter mcp;
+ * ScheduledExpanderAdapter encoders(mcp, 1, 10); // Every 1ms, high priority
+ * EventEncoder encoder(new ExpanderEncoderAdapter(0, 1, encoders));
+ * ```
+ */
+class ScheduledExpanderAdapter : public GpioExpanderAdapter {
+
+public:
+
+    /**
+     * @brief Construct a ScheduledExpanderAdapter
+     *
+     * @param expander The expander adapter to read
+     * @param intervalMs The interval between reads (0 to read on every ExpanderBusScheduler::update())
+     * @param priority Higher priority expanders are read first in each pass and are not deferred by the bus budget
+     * before lower priority ones
+     */
+    ScheduledExpanderAdapter(GpioExpanderAdapter& expander, uint16_t intervalMs = 10, uint8_t priority = 0)
+        : expander(&expander),
+          intervalMs(intervalMs),
+          priority(priority)
+        {}
+
+    /**
+     * @brief Begin the wrapped expander with its default begin().
+     */
+    void begin() override { expander->begin(); }
+
+    /**
+     * @brief Pick up the pins that changed on the scheduler's reads since the last update(). Does not read the bus.
+     */
+    void update() override {
+        changedBits = pendingBits;
+        pendingBits = 0;
+    }
+
+    bool read(byte pin) override { return expander->read(pin); }
+
+    uint32_t readAll() override { return expander->readAll(); }
+
+    /**
+     * @brief The pins that changed between the previous update() and this one (zero if the expander was not read).
+     */
+    uint32_t changedMask() override { return changedBits; }
+
+    /**
+     * @brief The time since the scheduler last read the expander (plus the expander's own sample age).
+     */
+    uint32_t sampleAgeMs() override {
+        if ( !samples ) return 0;
+        return InputEventsClock::now() - lastReadMs + expander->sampleAgeMs();
+    }
+
+    void attachPin(byte pin, int mode = INPUT_PULLUP) override { expander->attachPin(pin, mode); }
+
+    /**
+     * @brief Set the interval between reads. Takes effect after the next read.
+     */
+    void setInterval(uint16_t ms) { intervalMs = ms; }
+
+    uint16_t getInterval() { return intervalMs; }
+
+    uint8_t getPriority() { return priority; }
+
+    /**
+     * @brief The number of reads since the scheduler's statistics were reset.
+     */
+    uint32_t sampleCount() { return samples; }
+
+    /**
+     * @brief The time in microseconds spent in the expander's update() since the statistics were reset.
+     */
+    uint32_t busMicros() { return busUs; }
+
+    /**
+     * @brief The longest single update() of the expander in microseconds.
+     */
+    uint16_t maxReadMicros() { return maxReadUs; }
+
+    /**
+     * @brief The number of passes a due read was put off because the scheduler's bus budget had been used.
+     */
+    uint32_t deferrals() { return deferred; }
+
+    /**
+     * @brief The wrapped expander adapter.
+     */
+    GpioExpanderAdapter& getExpander() { return *expander; }
+
+private:
+    friend class ExpanderBusScheduler;
+
+    GpioExpanderAdapter* expander;
+    ScheduledExpanderAdapter* nextScheduled = nullptr; ///< Intrusive link used by ExpanderBusScheduler
+    uint32_t nextReadMs = 0;
+    uint32_t lastReadMs = 0;
+    uint32_t pendingBits = 0; ///< Changed on the scheduler's reads, not yet picked up by update()
+    uint32_t changedBits = 0;
+    uint32_t samples = 0;
+    uint32_t busUs = 0;
+    uint32_t deferred = 0;
+    uint16_t maxReadUs = 0;
+    uint16_t intervalMs;
+    uint8_t priority;
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_VERTICAL_COUNTER_DEBOUNCER_H
+#define INPUT_EVENTS_VERTICAL_COUNTER_DEBOUNCER_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Debounces a whole bank of pins (8, 16 or 32) at once using a 'vertical counter'.
+ *
+ * @details Each pin has a two bit counter, but the counters are stored 'vertically' - one word holds bit 0 of every
+ * counter and another holds bit 1 - so all of the pins are debounced with a handful of bitwise operations and no
+ * branches or per-pin timing.
+ *
+ * A pin's debounced state changes after it has been sampled in its new state four times in a row. Any sample in the
+ * old state resets that pin's counter. The debounce time is therefore four sample intervals, so update() should be
+ * called at a regular interval (see DebouncedExpanderAdapter).
+ *
+ * @tparam T uint8_t, uint16_t or uint32_t - one bit per pin
+ */
+template <typename T = uint32_t>
+class VerticalCounterDebouncer {
+
+public:
+
+    /**
+     * @brief Set the initial debounced state (eg the first read of the pins).
+     */
+    void begin(T initialState) {
+        state = initialState;
+        count0 = count1 = (T)~(T)0;
+        changedBits = 0;
+    }
+
+    /**
+     * @brief Debounce a new sample of all of the pins.
+     *
+     * @param sample The raw pin states, one bit per pin
+     * @return T The debounced pin states
+     */
+    T update(T sample) {
+        T delta = state ^ sample;               // Pins that differ from their debounced state
+        count0 = (T)~(count0 & delta);          // Count down while different, reset to 3 when the same
+        count1 = (T)(count0 ^ (count1 & delta));
+        changedBits = (T)(delta & count0 & count1); // Counter rolled over
+        state ^= changedBits;
+        return state;
+    }
+
+    /**
+     * @brief The debounced pin states.
+     */
+    T read() const { return state; }
+
+    /**
+     * @brief The pins whose debounced state changed on the last update().
+     */
+    T changed() const { return changedBits; }
+
+    /**
+     * @brief Returns true if any pin is part way through a change (ie more samples are needed).
+     */
+    bool isSettling() const { return (T)(count0 & count1) != (T)~(T)0; }
+
+private:
+    T state = 0;
+    T count0 = (T)~(T)0;
+    T count1 = (T)~(T)0;
+    T changedBits = 0;
+};
+
+#endif
@@ -0,0 +1,78 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_WIRE_ASYNC_I2C_BUS_H
+#define INPUT_EVENTS_WIRE_ASYNC_I2C_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "GpioExpanderAdapter/AsyncI2CBus.h"
+
+/**
+ * @brief An AsyncI2CBus using the Arduino Wire library.
+ *
+ * @details This is *not* a non-blocking bus. Wire has no non-blocking read, so the whole transfer happens in
+ * startRead() and the status is DONE (or FAILED) straight away. The AsyncI2CExpanderAdapter behaves the same, but
+ * update() blocks for the transfer as the regular expander adapters do. The library does not include a non-blocking
+ * AsyncI2CBus - use this until you have implemented one for your board.
+ */
+class WireAsyncI2CBus : public AsyncI2CBus {
+
+public:
+
+    /**
+     * @brief Construct a WireAsyncI2CBus
+     *
+     * @param wire Default is Wire
+     */
+    WireAsyncI2CBus(TwoWire& wire = Wire)
+        : wire(&wire)
+        {}
+
+    /**
+     * @brief Calls Wire.begin()
+     */
+    void begin() override { wire->begin(); }
+
+    bool startRead(uint8_t address, uint8_t length, int16_t reg = NO_REGISTER) override {
+        if ( state != Status::IDLE ) return false;
+        if ( length > MAX_LENGTH ) length = MAX_LENGTH;
+        received = 0;
+        state = Status::FAILED;
+        if ( reg != NO_REGISTER ) {
+            wire->beginTransmission(address);
+            wire->write((uint8_t)reg);
+            if ( wire->endTransmission(false) != 0 ) return true;
+        }
+        if ( wire->requestFrom(address, length) != length ) return true;
+        while ( received < length && wire->available() ) {
+            data[received++] = (uint8_t)wire->read();
+        }
+        if ( received == length ) state = Status::DONE;
+        return true;
+    }
+
+    Status status() override { return state; }
+
+    uint8_t takeData(uint8_t* buffer) override {
+        uint8_t length = state == Status::DONE ? received : 0;
+        for (uint8_t i = 0; i < length; i++) {
+            buffer[i] = data[i];
+        }
+        state = Status::IDLE;
+        return length;
+    }
+
+private:
+    TwoWire* wire;
+    Status state = Status::IDLE;
+    uint8_t data[MAX_LENGTH];
+    uint8_t received = 0;
+};
+
+#endif
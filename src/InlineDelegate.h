@@ -0,0 +1,189 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_INLINE_DELEGATE_H
+#define INPUT_EVENTS_INLINE_DELEGATE_H
+
+#include <Arduino.h>
+
+/// \cond DO_NOT_DOCUMENT
+/*
+ * A tagged placement new so we do not depend on <new> (not available on all AVR cores)
+ * or clash with a core's own placement new.
+ */
+struct InlineDelegatePlacement {};
+inline void* operator new(size_t, void* ptr, InlineDelegatePlacement) noexcept { return ptr; }
+inline void operator delete(void*, void*, InlineDelegatePlacement) noexcept {}
+
+namespace InlineDelegateDetail {
+    // Minimal type traits - <type_traits> is not available on AVR
+    template <typename T> struct RemoveRef { typedef T type; };
+    template <typename T> struct RemoveRef<T&> { typedef T type; };
+    template <typename T> struct RemoveRef<T&&> { typedef T type; };
+    template <typename T> struct RemoveConst { typedef T type; };
+    template <typename T> struct RemoveConst<const T> { typedef T type; };
+    template <typename T> struct Decay { typedef typename RemoveConst<typename RemoveRef<T>::type>::type type; };
+    template <typename R, typename... A> struct Decay<R(A...)> { typedef R (*type)(A...); };
+    template <typename R, typename... A> struct Decay<R(&)(A...)> { typedef R (*type)(A...); };
+    template <typename A, typename B> struct IsSame { static constexpr bool value = false; };
+    template <typename A> struct IsSame<A, A> { static constexpr bool value = true; };
+    template <bool B, typename T = void> struct EnableIf {};
+    template <typename T> struct EnableIf<true, T> { typedef T type; };
+}
+/// \endcond
+
+template <typename Signature, size_t Capacity = 3 * sizeof(void*)>
+class InlineDelegate;
+
+/**
+ * @brief A fixed size callable - a free function, a class method or a (capturing) lambda - that never uses the heap.
+ *
+ * @details This is the type of the InputEvents callbacks (eg EventButton::CallbackFunction). The callable is copied
+ * into storage inside the delegate, so unlike <code>std::function</code> there is no heap allocation and a call is a
+ * single indirect function call.
+ *
+ * The default capacity (three pointers) will hold a function pointer, a class instance with a method pointer or a
+ * lambda capturing up to three pointers (eg <code>[this]</code> or <code>[&amp;]</code>). A larger callable will fail
+ * to compile with a static_assert.
+ *
+ * @tparam R The return type
+ * @tparam Args The argument types
+ * @tparam Capacity The size of the storage in bytes
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineDelegate<R(Args...), Capacity> {
+
+public:
+
+    /**
+     * @brief Construct an empty delegate.
+     */
+    InlineDelegate() {}
+
+    /**
+     * @brief Construct an empty delegate.
+     */
+    InlineDelegate(decltype(nullptr)) {}
+
+    /**
+     * @brief Construct a delegate from a function pointer or lambda.
+     *
+     * @param f The callable. Must be no larger than Capacity.
+     */
+    template <typename Fn, typename D = typename InlineDelegateDetail::Decay<Fn>::type,
+              typename = typename InlineDelegateDetail::EnableIf<!InlineDelegateDetail::IsSame<D, InlineDelegate>::value>::type>
+    InlineDelegate(Fn&& f) {
+        emplace<D>(static_cast<Fn&&>(f));
+    }
+
+    /**
+     * @brief Construct a delegate that calls a method on a class instance.
+     *
+     * @param instance The instance of the class
+     * @param method The class method
+     */
+    template <typename T>
+    InlineDelegate(T* instance, R (T::*method)(Args...)) {
+        emplace<MethodCall<T>>(MethodCall<T>{instance, method});
+    }
+
+    InlineDelegate(const InlineDelegate& other) {
+        copyFrom(other);
+    }
+
+    InlineDelegate& operator=(const InlineDelegate& other) {
+        if ( this != &other ) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    InlineDelegate& operator=(decltype(nullptr)) {
+        reset();
+        return *this;
+    }
+
+    ~InlineDelegate() {
+        reset();
+    }
+
+    /**
+     * @brief Call the delegate. Must not be empty.
+     */
+    R operator()(Args... args) const {
+        return invoker(storage, static_cast<Args&&>(args)...);
+    }
+
+    /**
+     * @brief Returns true if the delegate is not empty.
+     */
+    explicit operator bool() const { return invoker != nullptr; }
+
+    bool operator==(decltype(nullptr)) const { return invoker == nullptr; }
+    bool operator!=(decltype(nullptr)) const { return invoker != nullptr; }
+
+private:
+
+    enum class Op : uint8_t { COPY, DESTROY };
+
+    union Storage {
+        void* object;
+        void (*function)();
+        unsigned long long alignment;
+        unsigned char bytes[Capacity];
+    };
+
+    template <typename T>
+    struct MethodCall {
+        T* instance;
+        R (T::*method)(Args...);
+        R operator()(Args... args) const { return (instance->*method)(static_cast<Args&&>(args)...); }
+    };
+
+    Storage storage;
+    R (*invoker)(const Storage&, Args...) = nullptr;
+    void (*manager)(Op, Storage&, const Storage*) = nullptr;
+
+    template <typename Fn, typename A>
+    void emplace(A&& f) {
+        static_assert(sizeof(Fn) <= Capacity, "Callable is too large for the InlineDelegate - capture less or increase Capacity");
+        new (&storage, InlineDelegatePlacement()) Fn(static_cast<A&&>(f));
+        invoker = &invoke<Fn>;
+        manager = &manage<Fn>;
+    }
+
+    template <typename Fn>
+    static R invoke(const Storage& s, Args... args) {
+        return (*reinterpret_cast<Fn*>(const_cast<unsigned char*>(s.bytes)))(static_cast<Args&&>(args)...);
+    }
+
+    template <typename Fn>
+    static void manage(Op op, Storage& dst, const Storage* src) {
+        if ( op == Op::COPY ) {
+            new (&dst, InlineDelegatePlacement()) Fn(*reinterpret_cast<const Fn*>(src->bytes));
+        } else {
+            reinterpret_cast<Fn*>(dst.bytes)->~Fn();
+        }
+    }
+
+    void copyFrom(const InlineDelegate& other) {
+        if ( other.manager ) other.manager(Op::COPY, storage, &other.storage);
+        invoker = other.invoker;
+        manager = other.manager;
+    }
+
+    void reset() {
+        if ( manager ) manager(Op::DESTROY, storage, nullptr);
+        invoker = nullptr;
+        manager = nullptr;
+    }
+
+};
+
+#endif
@@ -0,0 +1,12 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "InputEventsClock.h"
+
+bool InputEventsClock::frozen = false;
+uint32_t InputEventsClock::frozenMs = 0;
@@ -0,0 +1,101 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_CLOCK_H
+#define INPUT_EVENTS_CLOCK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The time source for all InputEvents inputs and debouncers.
+ *
+ * @details By default now() simply returns millis() but while an InputEventsClock::Snapshot is in scope, now() returns
+ * the time captured by the snapshot. InputManager::update() takes a snapshot for each pass so every input and
+ * debouncer in that pass uses the same, consistent, timestamp and millis() is only read once.
+ *
+ * If you update inputs individually, you can take your own snapshot in <code>loop()</code>:
+ * ```
+ * void loop() {
+ *     InputEventsClock::Snapshot now;
+ *     myButton.update();
+ *     mySwitch.update();
+ * }
+ * ```
+ *
+ */
+class InputEventsClock {
+
+public:
+
+    /**
+     * @brief Returns the snapshot time if a Snapshot is in scope, otherwise millis().
+     */
+    static uint32_t now() { return frozen ? frozenMs : millis(); }
+
+    /**
+     * @brief Returns true if a Snapshot is currently in scope.
+     */
+    static bool isFrozen() { return frozen; }
+
+    /**
+     * @brief Returns true if the time ms has been reached (safe across millis() rollover).
+     *
+     * @param ms A time in milliseconds, eg a deadline
+     */
+    static bool hasReached(uint32_t ms) { return (int32_t)(now() - ms) >= 0; }
+
+    /**
+     * @brief Returns true if time a is before time b (safe across millis() rollover).
+     */
+    static bool isBefore(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+    /**
+     * @brief While in scope, InputEventsClock::now() will return the captured time.
+     *
+     * @details Snapshots can be nested - the previous snapshot (if any) is restored when the Snapshot goes out of scope.
+     */
+    class Snapshot {
+    public:
+        /**
+         * @brief Capture the current time (or the time of an enclosing Snapshot).
+         */
+        Snapshot() : Snapshot(InputEventsClock::now()) {}
+
+        /**
+         * @brief Use a time that has already been captured.
+         *
+         * @param nowMs The time in milliseconds, normally from millis()
+         */
+        Snapshot(uint32_t nowMs)
+            : prevFrozen(InputEventsClock::frozen),
+              prevMs(InputEventsClock::frozenMs)
+            {
+                InputEventsClock::frozenMs = nowMs;
+                InputEventsClock::frozen = true;
+            }
+
+        ~Snapshot() {
+            InputEventsClock::frozenMs = prevMs;
+            InputEventsClock::frozen = prevFrozen;
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+    private:
+        bool prevFrozen;
+        uint32_t prevMs;
+    };
+
+private:
+    static bool frozen;
+    static uint32_t frozenMs;
+
+};
+
+#endif
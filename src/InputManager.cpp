@@ -0,0 +1,263 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "InputManager.h"
+
+void InputManager::add(EventInputBase& input) {
+    for (EventInputBase* in = head; in; in = in->nextInput) {
+        if ( in == &input ) return; //Already added
+    }
+    input.nextInput = nullptr;
+    if ( tail ) {
+        tail->nextInput = &input;
+    } else {
+        head = &input;
+        CycleCounter::begin();
+    }
+    tail = &input;
+    inputCount++;
+    if ( scheduling ) reschedule(&input);
+    if ( sleeper && !input.attachWakeSource(*sleeper) ) allInputsWake = false;
+}
+
+bool InputManager::remove(EventInputBase& input) {
+    EventInputBase* prev = nullptr;
+    for (EventInputBase* in = head; in; prev = in, in = in->nextInput) {
+        if ( in != &input ) continue;
+        if ( prev ) {
+            prev->nextInput = in->nextInput;
+        } else {
+            head = in->nextInput;
+        }
+        if ( tail == in ) tail = prev;
+        in->nextInput = nullptr;
+        inputCount--;
+        timers.cancel(*in);
+        if ( sleeper ) attachWakeSources();
+        return true;
+    }
+    return false;
+}
+
+void InputManager::add(ExpanderInputDispatcher& dispatcher) {
+    ExpanderInputDispatcher** link = &dispatchers;
+    for (; *link; link = &(*link)->nextDispatcher) {
+        if ( *link == &dispatcher ) return; //Already added
+    }
+    dispatcher.nextDispatcher = nullptr;
+    dispatcher.manager = this;
+    *link = &dispatcher;
+    if ( !head ) CycleCounter::begin();
+    if ( scheduling ) scheduleSubscribers(&dispatcher, true);
+    if ( sleeper ) attachWakeSources();
+}
+
+bool InputManager::remove(ExpanderInputDispatcher& dispatcher) {
+    for (ExpanderInputDispatcher** link = &dispatchers; *link; link = &(*link)->nextDispatcher) {
+        if ( *link != &dispatcher ) continue;
+        scheduleSubscribers(&dispatcher, false);
+        *link = dispatcher.nextDispatcher;
+        dispatcher.nextDispatcher = nullptr;
+        dispatcher.manager = nullptr;
+        if ( sleeper ) attachWakeSources();
+        return true;
+    }
+    return false;
+}
+
+void InputManager::update() {
+    update(InputEventsClock::now());
+}
+
+void InputManager::update(uint32_t nowMs) {
+    uint32_t start = CycleCounter::read();
+    InputEventsClock::Snapshot snapshot(nowMs);
+    if ( scheduling ) timers.advance(nowMs);
+    for (ExpanderInputDispatcher* d = dispatchers; d; d = d->nextDispatcher) {
+        dispatch(d);
+    }
+    for (EventInputBase* in = head; in; in = in->nextInput) {
+        if ( !in->_enabled ) continue;
+        if ( !scheduling ) {
+            in->update();
+        } else if ( isDue(in) ) {
+            in->update();
+            reschedule(in);
+        } else {
+            skipped++;
+        }
+    }
+    if ( scheduling && dispatchers ) updateDue();
+    lastCycles = CycleCounter::read() - start;
+    if ( lastCycles > maxCycles ) maxCycles = lastCycles;
+    passes++;
+}
+
+void InputManager::dispatch(ExpanderInputDispatcher* dispatcher) {
+    dispatcher->expander->update();
+    if ( !scheduling || !dispatcher->primed ) {
+        for (uint32_t pins = dispatcher->firstPins; pins; pins &= pins - 1) {
+            EventInputBase* in = dispatcher->inputs[__builtin_ctzl(pins)];
+            if ( !in->_enabled ) continue;
+            in->update();
+            if ( scheduling ) reschedule(in);
+        }
+        dispatcher->primed = true;
+        return;
+    }
+    uint32_t pins = dispatcher->expander->changedMask() & dispatcher->subscribed;
+    while ( pins ) {
+        EventInputBase* in = dispatcher->inputs[__builtin_ctzl(pins)];
+        //Clear the input's other changed pins (eg encoder A and B) so it is only updated once
+        for (uint32_t rest = pins; rest; rest &= rest - 1) {
+            uint8_t pin = __builtin_ctzl(rest);
+            if ( dispatcher->inputs[pin] == in ) pins &= ~((uint32_t)1 << pin);
+        }
+        if ( !in->_enabled ) continue;
+        in->update();
+        reschedule(in);
+    }
+}
+
+void InputManager::updateDue() {
+    //Due polled inputs have already been updated and rescheduled, so only disabled inputs and dispatcher subscribers remain
+    EventInputBase* in = timers.firstDue();
+    while ( in ) {
+        EventInputBase* next = TimerWheel::nextDue(*in);
+        if ( in->_enabled ) {
+            in->update();
+            reschedule(in);
+        }
+        in = next;
+    }
+}
+
+void InputManager::scheduleSubscribers(ExpanderInputDispatcher* dispatcher, bool enable) {
+    for (uint32_t pins = dispatcher->firstPins; pins; pins &= pins - 1) {
+        EventInputBase* in = dispatcher->inputs[__builtin_ctzl(pins)];
+        if ( enable ) {
+            reschedule(in);
+        } else {
+            timers.cancel(*in);
+        }
+    }
+}
+
+void InputManager::enableScheduling(bool enable /*=true*/) {
+    if ( enable && !scheduling ) {
+        InputEventsClock::Snapshot snapshot;
+        timers.begin(InputEventsClock::now());
+        for (EventInputBase* in = head; in; in = in->nextInput) {
+            reschedule(in);
+        }
+        for (ExpanderInputDispatcher* d = dispatchers; d; d = d->nextDispatcher) {
+            scheduleSubscribers(d, true);
+        }
+    } else if ( !enable ) {
+        for (EventInputBase* in = head; in; in = in->nextInput) {
+            timers.cancel(*in);
+        }
+        for (ExpanderInputDispatcher* d = dispatchers; d; d = d->nextDispatcher) {
+            scheduleSubscribers(d, false);
+        }
+    }
+    scheduling = enable;
+}
+
+bool InputManager::isDue(EventInputBase* input) {
+    return TimerWheel::isDue(*input) || input->hasInputChanged();
+}
+
+void InputManager::reschedule(EventInputBase* input) {
+    uint32_t deadlineMs;
+    if ( input->nextDeadline(deadlineMs) ) {
+        timers.schedule(*input, deadlineMs);
+    } else {
+        timers.cancel(*input);
+    }
+}
+
+bool InputManager::nextDeadline(uint32_t& deadlineMs) {
+    bool found = false;
+    uint32_t ms;
+    for (EventInputBase* in = head; in; in = in->nextInput) {
+        if ( !in->_enabled ) continue;
+        if ( (scheduling && TimerWheel::isDue(*in)) || in->hasInputChanged() ) {
+            deadlineMs = InputEventsClock::now();
+            return true;
+        }
+        if ( !scheduling && in->nextDeadline(ms) ) {
+            EventInputBase::mergeDeadline(found, deadlineMs, ms);
+        }
+    }
+    //Subscriber pins are only read by update() so only their deadlines are checked here
+    for (ExpanderInputDispatcher* d = dispatchers; d && !scheduling; d = d->nextDispatcher) {
+        for (uint32_t pins = d->firstPins; pins; pins &= pins - 1) {
+            EventInputBase* in = d->inputs[__builtin_ctzl(pins)];
+            if ( in->_enabled && in->nextDeadline(ms) ) {
+                EventInputBase::mergeDeadline(found, deadlineMs, ms);
+            }
+        }
+    }
+    if ( scheduling ) {
+        for (EventInputBase* in = timers.firstDue(); in; in = TimerWheel::nextDue(*in)) {
+            if ( !in->_enabled ) continue;
+            deadlineMs = InputEventsClock::now();
+            return true;
+        }
+        found = timers.nextDeadline(deadlineMs);
+    }
+    return found;
+}
+
+void InputManager::setSleepAdapter(SleepAdapter* sleepAdapter) {
+    sleeper = sleepAdapter;
+    if ( sleeper ) {
+        sleeper->begin();
+        attachWakeSources();
+    }
+}
+
+void InputManager::attachWakeSources() {
+    allInputsWake = true;
+    for (EventInputBase* in = head; in; in = in->nextInput) {
+        if ( !in->attachWakeSource(*sleeper) ) allInputsWake = false;
+    }
+    for (ExpanderInputDispatcher* d = dispatchers; d; d = d->nextDispatcher) {
+        for (uint32_t pins = d->firstPins; pins; pins &= pins - 1) {
+            if ( !d->inputs[__builtin_ctzl(pins)]->attachWakeSource(*sleeper) ) allInputsWake = false;
+        }
+    }
+}
+
+void InputManager::unsubscribed(EventInputBase& input) {
+    timers.cancel(input);
+}
+
+void InputManager::subscribersChanged() {
+    if ( sleeper ) attachWakeSources();
+}
+
+bool InputManager::sleep() {
+    if ( !canSleep() ) return false;
+    uint32_t deadlineMs;
+    if ( !nextDeadline(deadlineMs) ) {
+        sleeper->sleep(SleepAdapter::NO_TIMEOUT);
+        return true;
+    }
+    if ( InputEventsClock::hasReached(deadlineMs) ) return false;
+    sleeper->sleep(deadlineMs - InputEventsClock::now());
+    return true;
+}
+
+void InputManager::resetStats() {
+    lastCycles = 0;
+    maxCycles = 0;
+    passes = 0;
+    skipped = 0;
+}
@@ -0,0 +1,259 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_INPUT_MANAGER_H
+#define INPUT_EVENTS_INPUT_MANAGER_H
+
+#include <Arduino.h>
+#include "EventInputBase.h"
+#include "CycleCounter.h"
+#include "InputEventsClock.h"
+#include "TimerWheel.h"
+#include "ExpanderInputDispatcher.h"
+#include "SleepAdapter/SleepAdapter.h"
+
+/**
+ * @brief The InputManager updates any number of inputs from a single call in <code>loop()</code>.
+ *
+ * @details Inputs are added once (usually in <code>setup()</code>) and are then updated in the order they were added
+ * each time InputManager::update() is called.
+ *
+ * Inputs are held in an intrusive linked list (the link is a member of EventInputBase) so no heap is used, however
+ * an input can only be added to one InputManager.
+ *
+ * millis() is read once at the start of each pass and the same timestamp (via InputEventsClock) is used by every input
+ * and debouncer in that pass.
+ *
+ * Disabled inputs are skipped without touching their state. Note: this means an EventAnalog will not auto calibrate while disabled.
+ *
+ * Only add the 'outer' input - do not add the EventEncoder and EventButton of an EventEncoderButton or the EventAnalog axis of an EventJoystick.
+ *
+ * GPIO expanders must still be updated before the InputManager, unless their inputs are added via an
+ * ExpanderInputDispatcher. The manager then updates the expander itself and (with scheduling) only updates the
+ * inputs whose expander pins have changed.
+ *
+ * With enableScheduling(), an input is only updated if its pin(s) have changed or one of its deadlines
+ * (idle timeout, LONG_PRESS, multi click, debounce, encoder rate limit) has been reached. nextDeadline() returns the
+ * earliest of these so the sketch can sleep (or do other work) until then. Deadlines are held in a TimerWheel so
+ * timeout processing only costs time for the inputs that are actually due.
+ *
+ * With a SleepAdapter, sleep() halts the MCU until either an input pin changes or the next deadline is reached.
+ *
+ */
+class InputManager {
+
+public:
+
+    /**
+     * @brief Add an input. Inputs are updated in the order they are added. Adding an input twice has no effect.
+     *
+     * @param input Any InputEvents input, eg EventButton, EventEncoder etc.
+     */
+    void add(EventInputBase& input);
+
+    /**
+     * @brief Remove a previously added input.
+     *
+     * @param input The input to be removed
+     * @return true The input was found and removed
+     * @return false The input had not been added
+     */
+    bool remove(EventInputBase& input);
+
+    /**
+     * @brief Add an ExpanderInputDispatcher. Its expander is updated, followed by its subscribers, at the start of each pass.
+     *
+     * @details Do not also add the dispatcher's subscribers with add(EventInputBase&). Adding a dispatcher twice has no effect.
+     *
+     * @param dispatcher The dispatcher
+     */
+    void add(ExpanderInputDispatcher& dispatcher);
+
+    /**
+     * @brief Remove a previously added ExpanderInputDispatcher.
+     *
+     * @param dispatcher The dispatcher to be removed
+     * @return true The dispatcher was found and removed
+     * @return false The dispatcher had not been added
+     */
+    bool remove(ExpanderInputDispatcher& dispatcher);
+
+    /**
+     * @brief Update all enabled inputs.
+     *
+     * @details *Must* be called from within <code>loop()</code>
+     */
+    void update();
+
+    /**
+     * @brief Update all enabled inputs using an already captured time.
+     *
+     * @param nowMs The time in milliseconds (normally from millis()) used by all inputs for this pass.
+     */
+    void update(uint32_t nowMs);
+
+    /**
+     * @brief Returns the number of inputs that have been added.
+     */
+    uint16_t count() { return inputCount; }
+
+    ///@{
+    /**
+     * @name Scheduling
+     */
+    /**
+     * @brief Only update inputs that have changed or have reached their next deadline. Default is false (update all enabled inputs every pass).
+     *
+     * @details The subscribers of an ExpanderInputDispatcher are not checked at all unless their expander pins have
+     * changed or their deadline has been reached.
+     *
+     * An input's deadline is recalculated after each of its updates. If you change a timeout (eg setIdleTimeout())
+     * between updates, the new timeout applies from the input's next update.
+     *
+     * @param enable true to enable scheduling
+     */
+    void enableScheduling(bool enable=true);
+
+    /**
+     * @brief Returns true if scheduling is enabled.
+     */
+    bool isSchedulingEnabled() { return scheduling; }
+
+    /**
+     * @brief Returns true if any enabled input has a pending deadline (or has changed) and sets deadlineMs to the earliest.
+     *
+     * @details If an input has changed, deadlineMs is set to InputEventsClock::now() ie update() should be called straight away.
+     * Use InputEventsClock::hasReached() to test the deadline.
+     *
+     * @param deadlineMs Set to the time at which update() next needs to be called.
+     * @return true A deadline is pending
+     * @return false Nothing is pending - update() only needs to be called when a pin changes
+     */
+    bool nextDeadline(uint32_t& deadlineMs);
+
+    /**
+     * @brief The number of input updates skipped by scheduling since the last resetStats().
+     */
+    uint32_t skippedCount() { return skipped; }
+    ///@}
+
+    ///@{
+    /**
+     * @name Low Power
+     */
+    /**
+     * @brief Set the SleepAdapter used by sleep() and arm the pins of all inputs (current and future) as wake sources.
+     *
+     * @param sleepAdapter eg a GpioSleepAdapter or nullptr to unset.
+     */
+    void setSleepAdapter(SleepAdapter* sleepAdapter);
+
+    /**
+     * @brief Returns true if a SleepAdapter is set and every added input can wake the MCU.
+     */
+    bool canSleep() { return sleeper != nullptr && allInputsWake; }
+
+    /**
+     * @brief Sleep until an input pin changes or the next deadline is reached.
+     *
+     * @details Call after update() in <code>loop()</code>. Returns immediately (without sleeping) if any input has
+     * changed or a deadline has already been reached.
+     *
+     * @return true The MCU slept
+     * @return false canSleep() is false or there was work to do
+     */
+    bool sleep();
+    ///@}
+
+    ///@{
+    /**
+     * @name Pass Statistics
+     * @details The cost of each update() pass is measured in CPU cycles on boards with a cycle counter
+     * (ESP32, ESP8266, RP2040 and Teensy) and in microseconds on all other boards (see CycleCounter::isMicros()).
+     */
+
+    /**
+     * @brief The cycles (or microseconds) taken by the most recent update() pass.
+     */
+    uint32_t lastPassCycles() { return lastCycles; }
+
+    /**
+     * @brief The maximum cycles (or microseconds) taken by an update() pass since the last resetStats().
+     */
+    uint32_t maxPassCycles() { return maxCycles; }
+
+    /**
+     * @brief The number of update() passes since the last resetStats().
+     */
+    uint32_t passCount() { return passes; }
+
+    /**
+     * @brief Reset the pass statistics.
+     */
+    void resetStats();
+    ///@}
+
+private:
+    EventInputBase* head = nullptr;
+    EventInputBase* tail = nullptr;
+    ExpanderInputDispatcher* dispatchers = nullptr;
+    uint16_t inputCount = 0;
+    bool scheduling = false;
+    TimerWheel timers;
+    SleepAdapter* sleeper = nullptr;
+    bool allInputsWake = true;
+
+    uint32_t lastCycles = 0;
+    uint32_t maxCycles = 0;
+    uint32_t passes = 0;
+    uint32_t skipped = 0;
+
+    /**
+     * @brief Returns true if the input needs to be updated in this pass.
+     */
+    bool isDue(EventInputBase* input);
+
+    /**
+     * @brief Put the input's nextDeadline() (if any) in the timer wheel.
+     */
+    void reschedule(EventInputBase* input);
+
+    /**
+     * @brief Update a dispatcher's expander and then its subscribers (only those that have changed when scheduling).
+     */
+    void dispatch(ExpanderInputDispatcher* dispatcher);
+
+    /**
+     * @brief Update the enabled inputs left in the timer wheel's due list (ie the due dispatcher subscribers).
+     */
+    void updateDue();
+
+    /**
+     * @brief Reschedule (or cancel if enable is false) every subscriber of the dispatcher.
+     */
+    void scheduleSubscribers(ExpanderInputDispatcher* dispatcher, bool enable);
+
+    /**
+     * @brief Arm the wake sources of all inputs and set allInputsWake.
+     */
+    void attachWakeSources();
+
+    friend class ExpanderInputDispatcher;
+
+    /**
+     * @brief Called by a dispatcher when an input is removed from all of its pins - cancel its deadline.
+     */
+    void unsubscribed(EventInputBase& input);
+
+    /**
+     * @brief Called by a dispatcher after its subscribers have changed - re-arm the wake sources.
+     */
+    void subscribersChanged();
+};
+
+#endif
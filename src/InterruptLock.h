@@ -0,0 +1,85 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_INTERRUPT_LOCK_H
+#define INPUT_EVENTS_INTERRUPT_LOCK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Disables interrupts for the lifetime of the lock, then restores their previous state.
+ *
+ * @details Unlike a noInterrupts()/interrupts() pair, this is safe to use from an interrupt or inside another
+ * critical section because interrupts are only re-enabled if they were enabled when the lock was taken.
+ * ```
+ * {
+ *     InterruptLock lock;
+ *     // ...interrupts are disabled
+ * } // ...and restored here
+ * ```
+ *
+ * The previous state is read from SREG on AVR, PRIMASK on ARM, PS on ESP8266 and the FreeRTOS interrupt mask on ESP32.
+ * Any other core can define INPUT_EVENTS_INTERRUPTS_ENABLED() (in its Arduino.h) to return the current state,
+ * otherwise interrupts are assumed to have been enabled.
+ *
+ */
+class InterruptLock {
+
+public:
+
+    /**
+     * @brief Disable interrupts if lock is true, otherwise do nothing (so a lock can be taken conditionally).
+     */
+    explicit InterruptLock(bool lock = true) : locked(lock) {
+        if ( locked ) state = disable();
+    }
+
+    ~InterruptLock() {
+        if ( locked ) restore(state);
+    }
+
+private:
+
+#if defined(__AVR__)
+    typedef uint8_t State;
+    static State disable() { State sreg = SREG; cli(); return sreg; }
+    static void restore(State sreg) { SREG = sreg; }
+#elif defined(__arm__)
+    typedef uint32_t State;
+    static State disable() {
+        State primask;
+        __asm__ volatile ("mrs %0, primask\n cpsid i" : "=r" (primask) :: "memory");
+        return primask;
+    }
+    static void restore(State primask) { __asm__ volatile ("msr primask, %0" :: "r" (primask) : "memory"); }
+#elif defined(ESP8266)
+    typedef uint32_t State;
+    static State disable() { return xt_rsil(15); }
+    static void restore(State ps) { xt_wsr_ps(ps); }
+#elif defined(ESP32)
+    typedef UBaseType_t State;
+    static State disable() { return portSET_INTERRUPT_MASK_FROM_ISR(); }
+    static void restore(State mask) { portCLEAR_INTERRUPT_MASK_FROM_ISR(mask); }
+#elif defined(INPUT_EVENTS_INTERRUPTS_ENABLED)
+    typedef bool State;
+    static State disable() { State enabled = INPUT_EVENTS_INTERRUPTS_ENABLED(); noInterrupts(); return enabled; }
+    static void restore(State enabled) { if ( enabled ) interrupts(); }
+#else
+    typedef bool State; // No way to read the state on this core - assume interrupts were enabled
+    static State disable() { noInterrupts(); return true; }
+    static void restore(State enabled) { if ( enabled ) interrupts(); }
+#endif
+
+    bool locked;
+    State state = State();
+
+    InterruptLock(const InterruptLock&) = delete;
+    InterruptLock& operator=(const InterruptLock&) = delete;
+};
+
+#endif
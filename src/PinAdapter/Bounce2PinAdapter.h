@@ -3,6 +3,7 @@
 
 #include "DebounceAdapter.h"
 #include "Bounce2.h"
+#include "../SleepAdapter/SleepAdapter.h"
 /**
  * @brief A PinAdapter for the Bounce2 library. Note: this is *not* a DebounceAdapter as Bounce2 
  * can only read the GPIO pins directly, not via a PinAdapter.
@@ -30,6 +31,10 @@ class Bounce2PinAdapter : public PinAdapter {
         return bounce->read();
     }
 
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override {
+        return sleepAdapter.attachWakePin(buttonPin);
+    }
+
     private:
     byte buttonPin;
     Bounce* bounce;
@@ -55,6 +55,15 @@ class DebounceAdapter : public PinAdapter {
         debounceInterval = interval;
     }
 
+    /**
+     * @brief Returns true if a state change is waiting to settle and sets deadlineMs to when it will be settled.
+     *
+     * @details Used by inputs to report their nextDeadline(). The default is false (no pending change).
+     *
+     * @param deadlineMs Set to the InputEventsClock time at which read() should next be called.
+     */
+    virtual bool nextDeadline(uint32_t& deadlineMs) { return false; }
+
     protected:
     PinAdapter* pinAdapter;
     uint16_t debounceInterval = 10;   
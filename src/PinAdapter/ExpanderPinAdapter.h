@@ -48,6 +48,14 @@ class ExpanderPinAdapter : public PinAdapter {
         return expanderAdapter->read(pin); 
     }
 
+    /**
+     * @brief Returns true if this pin changed on the last GpioExpanderAdapter::update() (or the expander cannot tell).
+     */
+    bool hasChanged() {
+        if ( !expanderAdapter ) return false;
+        return expanderAdapter->pinChanged(pin);
+    }
+
     private:
     byte pin;
     int mode;
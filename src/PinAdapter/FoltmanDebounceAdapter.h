@@ -3,6 +3,7 @@
 
 #include "Arduino.h"
 #include "DebounceAdapter.h"
+#include "InputEventsClock.h"
 
 /**
  * @brief This is the default InputEvents debouncer. Many thanks to @kfoltman.
@@ -16,26 +17,27 @@ class FoltmanDebounceAdapter : public DebounceAdapter {
 
     void begin() {
         DebounceAdapter::begin();
-        lastChangeMs = millis();
+        lastChangeMs = InputEventsClock::now();
         nextState = lastState = pinAdapter->read();
     }
 
     bool read() override {
         bool newState = pinAdapter->read();
+        uint32_t now = InputEventsClock::now();
         if (nextState == lastState) {
             // Steady state so far
             if (newState != nextState) {
                 // Initiating state change
                 nextState = newState;
-                lastChangeMs = millis();
+                lastChangeMs = now;
             }
         } else {
             // Change pending
             if (newState != nextState) {
                 // Glitch: reset the counter
                 nextState = lastState;
-                lastChangeMs = millis();
-            } else if (millis() - lastChangeMs >= debounceInterval) {
+                lastChangeMs = now;
+            } else if (now - lastChangeMs >= debounceInterval) {
                 // Got debounceInterval ms of glitchless signal
                 lastState = newState;
             }
@@ -43,6 +45,12 @@ class FoltmanDebounceAdapter : public DebounceAdapter {
         return lastState;
     }
 
+    bool nextDeadline(uint32_t& deadlineMs) override {
+        if ( nextState == lastState ) return false;
+        deadlineMs = lastChangeMs + debounceInterval;
+        return true;
+    }
+
     private:
     uint32_t lastChangeMs;
     bool lastState, nextState;
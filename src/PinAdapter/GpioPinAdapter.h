@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "PinAdapter.h"
+#include "../SleepAdapter/SleepAdapter.h"
 
 /**
  * @brief This is the default PinAdapter for regular GPIO pins.
@@ -43,6 +44,10 @@ class GpioPinAdapter : public PinAdapter {
         return digitalRead(buttonPin);
     }
 
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override {
+        return sleepAdapter.attachWakePin(buttonPin);
+    }
+
     private:
     byte buttonPin;
     uint8_t _pinMode = INPUT_PULLUP;
@@ -1,6 +1,8 @@
 #ifndef PinAdapter_h
 #define PinAdapter_h
 
+class SleepAdapter;
+
 /**
  * @brief The interface specification for button, encoder button and switch pins.
  * 
@@ -20,6 +22,14 @@ class PinAdapter {
      */
     virtual bool read() = 0;
 
+    /**
+     * @brief Arm the pin(s) as a wake source with the SleepAdapter.
+     * 
+     * @return true A change of state will wake the MCU
+     * @return false The default - the pin cannot wake the MCU
+     */
+    virtual bool attachWakeSource(SleepAdapter& sleepAdapter) { return false; }
+
     virtual ~PinAdapter() = default;
 };
 
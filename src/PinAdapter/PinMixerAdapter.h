@@ -47,6 +47,12 @@ class PinMixerAdapter : public PinAdapter {
         return state;
     }
 
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override {
+        bool wake1 = pin1->attachWakeSource(sleepAdapter);
+        bool wake2 = pin2->attachWakeSource(sleepAdapter);
+        return wake1 && wake2;
+    }
+
     private:
     PinAdapter* pin1;
     PinAdapter* pin2;
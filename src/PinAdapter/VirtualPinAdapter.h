@@ -37,6 +37,11 @@ class VirtualPinAdapter : public PinAdapter {
         return state;
     }
 
+    /**
+     * @brief Virtual pins are changed by the sketch itself so a change can never be missed while asleep.
+     */
+    bool attachWakeSource(SleepAdapter& sleepAdapter) override { return true; }
+
     /**
      * @brief Set the state to pressedState
      */
@@ -0,0 +1,50 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "GpioSleepAdapter.h"
+
+#if defined(ARDUINO_ARCH_AVR)
+    #include <avr/sleep.h>
+#endif
+
+volatile bool GpioSleepAdapter::pinChanged = false;
+
+bool GpioSleepAdapter::attachWakePin(byte pin) {
+    int irq = digitalPinToInterrupt(pin);
+    #ifdef NOT_AN_INTERRUPT
+    if ( irq == NOT_AN_INTERRUPT ) return false;
+    #endif
+    attachInterrupt(irq, GpioSleepAdapter::onPinChange, CHANGE);
+    return true;
+}
+
+void GpioSleepAdapter::sleep(uint32_t maxMs) {
+    uint32_t start = millis();
+    while ( !pinChanged && (maxMs == NO_TIMEOUT || (millis() - start) < maxMs) ) {
+        idle();
+    }
+    pinChanged = false;
+}
+
+void GpioSleepAdapter::idle() {
+    #if defined(ARDUINO_ARCH_AVR)
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    noInterrupts();
+    if ( !pinChanged ) {
+        sleep_enable();
+        interrupts(); // The instruction after sei is always executed, so the interrupt cannot be missed
+        sleep_cpu();
+        sleep_disable();
+    }
+    interrupts();
+    #elif defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_STM32) || defined(TEENSYDUINO)
+    __WFI(); // SysTick wakes every ms
+    #else
+    delay(1);
+    #endif
+}
@@ -0,0 +1,49 @@
+#ifndef GpioSleepAdapter_h
+#define GpioSleepAdapter_h
+
+#include <Arduino.h>
+#include "SleepAdapter.h"
+
+/**
+ * @brief A SleepAdapter using CHANGE interrupts on regular GPIO pins.
+ *
+ * @details This is a 1ms idle loop, not a timed sleep: the CPU is halted until the next interrupt, which is at most
+ * the next millis() tick, then the pins and the deadline are checked again. It saves the power of running loop()
+ * (and of polling every input) but the MCU never enters a deeper sleep, so the clocks and peripherals stay powered:
+ * - AVR: SLEEP_MODE_IDLE (the millis() timer wakes the CPU every ms)
+ * - SAMD, STM32 and Teensy: WFI (SysTick wakes the CPU every ms)
+ * - All other boards: delay(1), which yields to the RTOS/WiFi stack where there is one (eg ESP32/ESP8266)
+ *
+ * For a deeper sleep bounded by the deadline (eg the watchdog on AVR or esp_light_sleep_start() with a timer wake on
+ * ESP32) implement a SleepAdapter that keeps (or corrects) millis() across the sleep.
+ *
+ * Only pins with an interrupt (see <code>digitalPinToInterrupt()</code>) can be attached.
+ *
+ */
+class GpioSleepAdapter : public SleepAdapter {
+
+    public:
+
+    void begin() override { }
+
+    bool attachWakePin(byte pin) override;
+
+    void sleep(uint32_t maxMs) override;
+
+    /**
+     * @brief Returns true if an attached pin has changed since the last sleep() returned.
+     */
+    static bool isWakePending() { return pinChanged; }
+
+    private:
+    static volatile bool pinChanged;
+    static void onPinChange() { pinChanged = true; }
+
+    /**
+     * @brief Halt the CPU until the next interrupt (or for about 1ms).
+     */
+    void idle();
+
+};
+
+#endif
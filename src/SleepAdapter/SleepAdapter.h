@@ -0,0 +1,48 @@
+#ifndef SleepAdapter_h
+#define SleepAdapter_h
+
+#include <Arduino.h>
+
+/**
+ * @brief The interface specification for putting the MCU to sleep until a pin changes or a time has elapsed.
+ *
+ * @details Used by InputManager::sleep(). The MCU must keep millis() running while asleep so the timing based events
+ * (LONG_PRESS, MULTI_CLICKED, IDLE etc) still fire on schedule.
+ *
+ */
+class SleepAdapter {
+
+    public:
+    /**
+     * @brief Used as the sleep() duration when there is no pending deadline (ie only a pin change will wake).
+     */
+    static constexpr uint32_t NO_TIMEOUT = 0xFFFFFFFF;
+
+    /**
+     * @brief Initialise the sleep adapter. Must be safe for repeated calls (Idempotent)
+     *
+     */
+    virtual void begin() = 0;
+
+    /**
+     * @brief Arm a wake source for the pin. Must be safe for repeated calls with the same pin.
+     *
+     * @param pin The regular GPIO pin number
+     * @return true A change on the pin will wake the MCU
+     * @return false The pin cannot wake the MCU (eg it is not an interrupt pin)
+     */
+    virtual bool attachWakePin(byte pin) = 0;
+
+    /**
+     * @brief Sleep until an attached pin changes or maxMs has elapsed.
+     *
+     * @details If an attached pin has changed since the last sleep() returned, this must return immediately.
+     *
+     * @param maxMs The maximum time to sleep in milliseconds or NO_TIMEOUT
+     */
+    virtual void sleep(uint32_t maxMs) = 0;
+
+    virtual ~SleepAdapter() = default;
+};
+
+#endif
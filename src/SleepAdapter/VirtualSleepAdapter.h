@@ -0,0 +1,59 @@
+#ifndef VirtualSleepAdapter_h
+#define VirtualSleepAdapter_h
+
+#include <Arduino.h>
+#include "SleepAdapter.h"
+
+/**
+ * @brief A SleepAdapter that does not sleep. It records what would have happened so sleep behaviour can be tested
+ * (eg on a host build) without hardware.
+ *
+ */
+class VirtualSleepAdapter : public SleepAdapter {
+
+    public:
+    /**
+     * @brief Construct a new Virtual Sleep Adapter
+     *
+     * @param canWake If false, attachWakePin() will report that pins cannot wake the MCU.
+     */
+    VirtualSleepAdapter(bool canWake = true)
+    : canWake(canWake)
+    { }
+
+    void begin() override { }
+
+    bool attachWakePin(byte pin) override {
+        if ( canWake ) attachedPins++;
+        return canWake;
+    }
+
+    void sleep(uint32_t maxMs) override {
+        sleeps++;
+        lastMaxMs = maxMs;
+    }
+
+    /**
+     * @brief The number of times sleep() has been called.
+     */
+    uint32_t sleepCount() { return sleeps; }
+
+    /**
+     * @brief The maxMs passed to the most recent sleep() or SleepAdapter::NO_TIMEOUT.
+     */
+    uint32_t lastSleepMs() { return lastMaxMs; }
+
+    /**
+     * @brief The number of successful attachWakePin() calls.
+     */
+    uint16_t attachedPinCount() { return attachedPins; }
+
+    private:
+    bool canWake = true;
+    uint32_t sleeps = 0;
+    uint32_t lastMaxMs = 0;
+    uint16_t attachedPins = 0;
+
+};
+
+#endif
@@ -0,0 +1,286 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_STATIC_EVENT_BUTTON_H
+#define INPUT_EVENTS_STATIC_EVENT_BUTTON_H
+
+#include <Arduino.h>
+#include "InputEvents.h"
+#include "InputEventsClock.h"
+
+/**
+ * @brief A compile time GPIO pin for StaticEventButton.
+ *
+ * @tparam PIN The regular GPIO pin number
+ * @tparam MODE Defaults to INPUT_PULLUP
+ */
+template <uint8_t PIN, uint8_t MODE = INPUT_PULLUP>
+struct StaticGpioPin {
+    static void begin() {
+        pinMode(PIN, MODE);
+        delayMicroseconds(2000); // Allow time for a passive R-C filter to charge (see GpioPinAdapter)
+    }
+    static bool read() { return digitalRead(PIN); }
+};
+
+/**
+ * @brief A compile time version of FoltmanDebounceAdapter for StaticEventButton.
+ *
+ * @tparam INTERVAL_MS The debounce interval (default 10ms)
+ */
+template <uint16_t INTERVAL_MS = 10>
+class StaticFoltmanDebouncer {
+public:
+    void begin(bool state, uint32_t nowMs) {
+        lastChangeMs = nowMs;
+        nextState = lastState = state;
+    }
+
+    bool read(bool newState, uint32_t nowMs) {
+        if (nextState == lastState) {
+            // Steady state so far
+            if (newState != nextState) {
+                // Initiating state change
+                nextState = newState;
+                lastChangeMs = nowMs;
+            }
+        } else {
+            // Change pending
+            if (newState != nextState) {
+                // Glitch: reset the counter
+                nextState = lastState;
+                lastChangeMs = nowMs;
+            } else if (nowMs - lastChangeMs >= INTERVAL_MS) {
+                // Got INTERVAL_MS of glitchless signal
+                lastState = newState;
+            }
+        }
+        return lastState;
+    }
+
+private:
+    uint32_t lastChangeMs = 0;
+    bool lastState = HIGH;
+    bool nextState = HIGH;
+};
+
+/**
+ * @brief No debouncing for StaticEventButton (eg hardware debounced buttons).
+ */
+class StaticNoDebouncer {
+public:
+    void begin(bool state, uint32_t nowMs) { }
+    bool read(bool newState, uint32_t nowMs) { return newState; }
+};
+
+/**
+ * @brief A compile time variant of EventButton. The pin, debouncer and event handler are template parameters.
+ *
+ * @details There are no virtual methods, no heap allocated adapters and no callback object, so the compiler can inline
+ * the pin read, the debounce and the button state machine into a single update().
+ *
+ * The events fired are the same as EventButton (PRESSED, RELEASED, CLICKED, DOUBLE_CLICKED, MULTI_CLICKED,
+ * LONG_CLICKED, LONG_PRESS and IDLE) and the default timings are the same.
+ *
+ * The handler is a class with a static method:
+ * ```
+ * struct MyHandler {
+ *     template <typename B>
+ *     static void onEvent(InputEventType et, B& button) { ... }
+ * };
+ * StaticEventButton<StaticGpioPin<2>, StaticFoltmanDebouncer<>, MyHandler> myButton;
+ * ```
+ *
+ * A StaticEventButton is not an EventInputBase, so it cannot be added to an InputManager and does not support event
+ * blocking, EventQueue or scheduling. Call update() from <code>loop()</code>.
+ *
+ * @tparam PIN A pin type with static begin() and read() methods, eg StaticGpioPin
+ * @tparam DEBOUNCER eg StaticFoltmanDebouncer or StaticNoDebouncer
+ * @tparam HANDLER A class with a static onEvent(InputEventType, StaticEventButton&) method
+ * @tparam PRESSED_STATE The pin state that represents 'pressed' (default LOW)
+ */
+template <typename PIN, typename DEBOUNCER, typename HANDLER, bool PRESSED_STATE = LOW>
+class StaticEventButton {
+
+public:
+
+    /**
+     * @brief Initialise the StaticEventButton
+     *
+     * @details *Must* be called from within <code>setup()</code>
+     */
+    void begin() {
+        PIN::begin();
+        uint32_t now = InputEventsClock::now();
+        bool state = PIN::read();
+        debouncer.begin(state, now);
+        pressed = (state == PRESSED_STATE);
+        stateChangeLastTime = now;
+        lastEventMs = now;
+    }
+
+    /**
+     * @brief Update the state of the button and fire events.
+     *
+     * @details *Must* be called from within <code>loop()</code>
+     */
+    void update() {
+        if ( !enabled ) return;
+        uint32_t now = InputEventsClock::now();
+        bool isPressedNow = (debouncer.read(PIN::read(), now) == PRESSED_STATE);
+        if ( isPressedNow != pressed ) {
+            pressed = isPressedNow;
+            durationOfPreviousState = now - stateChangeLastTime;
+            stateChangeLastTime = now;
+            if ( pressed ) {
+                fire(InputEventType::PRESSED, now);
+            } else {
+                clickFired = false;
+                clickCounter++;
+                prevClickCount = clickCounter;
+                fire(InputEventType::RELEASED, now);
+            }
+        }
+        uint32_t duration = now - stateChangeLastTime;
+        if ( pressed ) {
+            lastEventMs = now;
+            idleFired = false;
+            if ( duration > longPressThreshold ) {
+                setLongPressCounter(longPressCounter + 1);
+                if ( repeatLongPress || longPressCounter == 1 ) {
+                    fire(InputEventType::LONG_PRESS, now);
+                }
+            }
+        } else if ( !clickFired && duration > multiClickInterval ) {
+            clickFired = true;
+            if ( durationOfPreviousState > longClickDuration ) {
+                clickCounter = 0;
+                prevClickCount = 1;
+                fire(InputEventType::LONG_CLICKED, now);
+                setLongPressCounter(0);
+            } else {
+                if ( clickCounter == 1 ) {
+                    fire(InputEventType::CLICKED, now);
+                } else if ( clickCounter == 2 ) {
+                    fire(InputEventType::DOUBLE_CLICKED, now);
+                } else {
+                    fire(InputEventType::MULTI_CLICKED, now);
+                }
+                clickCounter = 0;
+            }
+        }
+        if ( !idleFired && (now - lastEventMs) > idleTimeout ) {
+            idleFired = true;
+            HANDLER::onEvent(InputEventType::IDLE, *this);
+        }
+    }
+
+    /**
+     * @brief Enable or disable the button. A disabled button does not read its pin or fire events.
+     */
+    void enable(bool e = true) {
+        enabled = e;
+        if ( !e ) {
+            clickCounter = 0;
+            setLongPressCounter(0);
+        }
+        idleFired = true;
+    }
+
+    /**
+     * @brief Returns true if the button is enabled.
+     */
+    bool isEnabled() { return enabled; }
+
+    /**
+     * @brief Returns true if the button is currently pressed.
+     */
+    bool isPressed() { return pressed; }
+
+    /**
+     * @brief Returns the number of clicks for CLICKED, DOUBLE_CLICKED and MULTI_CLICKED events.
+     */
+    uint8_t clickCount() { return prevClickCount; }
+
+    /**
+     * @brief Returns the number of times LONG_PRESS has fired during this press.
+     */
+    uint16_t longPressCount() { return longPressCounter; }
+
+    /**
+     * @brief The duration in milliseconds of the current state.
+     */
+    uint32_t currentDuration() { return InputEventsClock::now() - stateChangeLastTime; }
+
+    /**
+     * @brief The duration in milliseconds of the previous state.
+     */
+    uint32_t previousDuration() { return durationOfPreviousState; }
+
+    /**
+     * @brief Set the idle timeout in milliseconds (default 10000, 10 seconds)
+     */
+    void setIdleTimeout(uint32_t timeoutMs = 10000) { idleTimeout = timeoutMs; }
+
+    /**
+     * @brief Set the multi click interval in milliseconds (default 250ms)
+     */
+    void setMultiClickInterval(uint16_t intervalMs = 250) { multiClickInterval = intervalMs; }
+
+    /**
+     * @brief Set the duration of the *first* LONG_PRESS in milliseconds (default 750ms)
+     */
+    void setLongClickDuration(uint16_t longDurationMs = 750) { longClickDuration = longDurationMs; setLongPressCounter(longPressCounter); }
+
+    /**
+     * @brief Set the interval of *subsequent* LONG_PRESS events in milliseconds (default 500ms)
+     */
+    void setLongPressInterval(uint16_t intervalMs = 500) { longPressInterval = intervalMs; setLongPressCounter(longPressCounter); }
+
+    /**
+     * @brief Repeat LONG_PRESS every setLongPressInterval() while the button is held (default true)
+     */
+    void enableLongPressRepeat(bool repeat = true) { repeatLongPress = repeat; }
+
+private:
+    DEBOUNCER debouncer;
+
+    uint32_t stateChangeLastTime = 0;
+    uint32_t durationOfPreviousState = 0;
+    uint32_t lastEventMs = 0;
+    uint32_t idleTimeout = 10000;
+
+    uint16_t multiClickInterval = 250;
+    uint16_t longClickDuration = 750;
+    uint16_t longPressInterval = 500;
+    uint16_t longPressCounter = 0;
+    uint16_t longPressThreshold = 750; //The currentDuration() at which the next LONG_PRESS fires
+
+    uint8_t clickCounter = 0;
+    uint8_t prevClickCount = 0;
+
+    bool pressed = false;
+    bool clickFired = true;
+    bool repeatLongPress = true;
+    bool idleFired = true;
+    bool enabled = true;
+
+    void setLongPressCounter(uint16_t count) {
+        longPressCounter = count;
+        longPressThreshold = (uint16_t)(longClickDuration + (longPressCounter * longPressInterval));
+    }
+
+    void fire(InputEventType et, uint32_t now) {
+        lastEventMs = now;
+        idleFired = false;
+        HANDLER::onEvent(et, *this);
+    }
+
+};
+
+#endif
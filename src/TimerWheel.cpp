@@ -0,0 +1,153 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#include "TimerWheel.h"
+
+void TimerWheel::begin(uint32_t nowMs) {
+    currentMs = nowMs;
+}
+
+void TimerWheel::schedule(EventInputBase& input, uint32_t deadlineMs) {
+    unlink(input);
+    input.timerDueMs = deadlineMs;
+    place(input);
+}
+
+void TimerWheel::cancel(EventInputBase& input) {
+    unlink(input);
+    input.timerSlot = NOT_SCHEDULED;
+}
+
+void TimerWheel::place(EventInputBase& input) {
+    uint32_t delta = input.timerDueMs - currentMs;
+    if ( (int32_t)delta <= 0 ) {
+        markDue(input);
+        return;
+    }
+    uint8_t level = 0;
+    while ( level < LEVELS - 1 && delta >> (SLOT_BITS * (level + 1)) ) {
+        level++;
+    }
+    uint32_t slotMs = input.timerDueMs;
+    if ( delta >> (SLOT_BITS * LEVELS) ) {
+        slotMs = currentMs + ((uint32_t)1 << (SLOT_BITS * LEVELS)) - 1; //Beyond the wheel - park in the furthest top level slot
+    }
+    uint8_t slot = level * SLOTS + ((slotMs >> (SLOT_BITS * level)) & SLOT_MASK);
+    input.timerSlot = slot;
+    input.timerPrev = nullptr;
+    input.timerNext = slots[slot];
+    if ( slots[slot] ) slots[slot]->timerPrev = &input;
+    slots[slot] = &input;
+    levelCount[level]++;
+    timerCount++;
+}
+
+void TimerWheel::markDue(EventInputBase& input) {
+    input.timerSlot = DUE;
+    input.timerPrev = nullptr;
+    input.timerNext = dueHead;
+    if ( dueHead ) dueHead->timerPrev = &input;
+    dueHead = &input;
+}
+
+void TimerWheel::unlink(EventInputBase& input) {
+    if ( input.timerSlot == DUE ) {
+        if ( input.timerPrev ) {
+            input.timerPrev->timerNext = input.timerNext;
+        } else {
+            dueHead = input.timerNext;
+        }
+        if ( input.timerNext ) input.timerNext->timerPrev = input.timerPrev;
+        input.timerNext = input.timerPrev = nullptr;
+        input.timerSlot = NOT_SCHEDULED;
+        return;
+    }
+    if ( input.timerSlot >= LEVELS * SLOTS ) return; //Not in a slot
+    if ( input.timerPrev ) {
+        input.timerPrev->timerNext = input.timerNext;
+    } else {
+        slots[input.timerSlot] = input.timerNext;
+    }
+    if ( input.timerNext ) input.timerNext->timerPrev = input.timerPrev;
+    input.timerNext = input.timerPrev = nullptr;
+    levelCount[input.timerSlot / SLOTS]--;
+    timerCount--;
+    input.timerSlot = NOT_SCHEDULED;
+}
+
+void TimerWheel::advance(uint32_t nowMs) {
+    while ( (int32_t)(nowMs - currentMs) > 0 ) {
+        if ( timerCount == 0 ) {
+            currentMs = nowMs;
+            return;
+        }
+        //Skip straight to the next boundary of the lowest level that has anything in it
+        uint8_t level = 0;
+        while ( level < LEVELS - 1 && levelCount[level] == 0 ) {
+            level++;
+        }
+        uint32_t step = (uint32_t)1 << (SLOT_BITS * level);
+        uint32_t nextMs = (currentMs | (step - 1)) + 1;
+        if ( (int32_t)(nextMs - nowMs) > 0 ) {
+            currentMs = nowMs; //Nothing happens before the boundary
+            return;
+        }
+        tick(nextMs);
+    }
+}
+
+void TimerWheel::tick(uint32_t tickMs) {
+    currentMs = tickMs;
+    //Cascade from the top down so inputs can drop through to level 0 in the same tick
+    for (uint8_t level = LEVELS - 1; level > 0; level--) {
+        if ( tickMs & (((uint32_t)1 << (SLOT_BITS * level)) - 1) ) continue; //Not a boundary for this level
+        uint8_t slot = level * SLOTS + ((tickMs >> (SLOT_BITS * level)) & SLOT_MASK);
+        EventInputBase* in = slots[slot];
+        slots[slot] = nullptr;
+        while ( in ) {
+            EventInputBase* next = in->timerNext;
+            levelCount[level]--;
+            timerCount--;
+            place(*in);
+            in = next;
+        }
+    }
+    uint8_t slot = tickMs & SLOT_MASK;
+    EventInputBase* in = slots[slot];
+    slots[slot] = nullptr;
+    while ( in ) {
+        EventInputBase* next = in->timerNext;
+        markDue(*in);
+        levelCount[0]--;
+        timerCount--;
+        in = next;
+    }
+}
+
+bool TimerWheel::nextDeadline(uint32_t& deadlineMs) {
+    bool found = false;
+    for (uint8_t level = 0; level < LEVELS; level++) {
+        if ( levelCount[level] == 0 ) continue;
+        //The first occupied slot after the current one holds the earliest deadlines of this level. Not so for the top
+        //level, where a parked deadline sits in a slot earlier than its time, so every slot is checked there.
+        bool lastLevel = level == LEVELS - 1;
+        uint8_t current = (currentMs >> (SLOT_BITS * level)) & SLOT_MASK;
+        for (uint8_t i = 1; i <= SLOTS; i++) {
+            EventInputBase* in = slots[level * SLOTS + ((current + i) & SLOT_MASK)];
+            if ( !in ) continue;
+            for (; in; in = in->timerNext) {
+                if ( !found || InputEventsClock::isBefore(in->timerDueMs, deadlineMs) ) {
+                    deadlineMs = in->timerDueMs;
+                    found = true;
+                }
+            }
+            if ( !lastLevel ) break;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,131 @@
+/**
+ *
+ * GPLv2 Licence https://www.gnu.org/licenses/old-licenses/gpl-2.0.txt
+ *
+ * Copyright (c) 2025 Philip Fletcher <philip.fletcher@stutchbury.com>
+ *
+ */
+
+#ifndef INPUT_EVENTS_TIMER_WHEEL_H
+#define INPUT_EVENTS_TIMER_WHEEL_H
+
+#include <Arduino.h>
+#include "EventInputBase.h"
+#include "InputEventsClock.h"
+
+/**
+ * @brief A hierarchical timer wheel holding one deadline (see EventInputBase::nextDeadline()) per input.
+ *
+ * @details Used by InputManager when scheduling is enabled so timeout processing (IDLE, LONG_PRESS, multi click etc)
+ * costs O(expired) rather than O(inputs) per pass.
+ *
+ * There are four levels of 16 slots with a 1ms tick, so deadlines up to 65.5 seconds ahead are placed directly.
+ * Later deadlines are parked in the top level and re-placed when they come into range. When a deadline is
+ * reached the input is marked as due (see isDue()) until it is rescheduled or cancelled. Due inputs are also held in
+ * a list (see firstDue()) so they can be found without checking every input.
+ *
+ * The slot lists are intrusive (the links are members of EventInputBase) so no heap is used. An input can only be
+ * scheduled in one TimerWheel.
+ *
+ */
+class TimerWheel {
+
+public:
+
+    static constexpr uint8_t NOT_SCHEDULED = 0xFF; ///< EventInputBase::timerSlot when not in the wheel
+    static constexpr uint8_t DUE = 0xFE; ///< EventInputBase::timerSlot once the deadline has been reached
+
+    /**
+     * @brief Set the wheel time. Must be called before the first schedule().
+     *
+     * @param nowMs Normally InputEventsClock::now()
+     */
+    void begin(uint32_t nowMs);
+
+    /**
+     * @brief Schedule (or reschedule) the input's deadline.
+     *
+     * @param input The input
+     * @param deadlineMs The time at which the input is due. A deadline that has already been reached is due immediately.
+     */
+    void schedule(EventInputBase& input, uint32_t deadlineMs);
+
+    /**
+     * @brief Remove the input from the wheel (and clear due).
+     */
+    void cancel(EventInputBase& input);
+
+    /**
+     * @brief Advance the wheel to nowMs, marking every input whose deadline has been reached as due.
+     */
+    void advance(uint32_t nowMs);
+
+    /**
+     * @brief Returns true if the input's deadline has been reached.
+     */
+    static bool isDue(EventInputBase& input) { return input.timerSlot == DUE; }
+
+    /**
+     * @brief Returns true if the input has a deadline in the wheel (or is due).
+     */
+    static bool isScheduled(EventInputBase& input) { return input.timerSlot != NOT_SCHEDULED; }
+
+    /**
+     * @brief The most recently due input (or nullptr). Use nextDue() to walk the rest of the due list.
+     *
+     * @details Rescheduling or cancelling an input removes it from the list, so read nextDue() first.
+     */
+    EventInputBase* firstDue() { return dueHead; }
+
+    /**
+     * @brief The input after a due input in the due list (or nullptr).
+     */
+    static EventInputBase* nextDue(EventInputBase& input) { return input.timerNext; }
+
+    /**
+     * @brief Returns true if an input is in the wheel and sets deadlineMs to the earliest deadline.
+     *
+     * @details Inputs that are already due are not included.
+     */
+    bool nextDeadline(uint32_t& deadlineMs);
+
+    /**
+     * @brief The number of inputs waiting in the wheel (not including those that are due).
+     */
+    uint16_t count() { return timerCount; }
+
+private:
+    static constexpr uint8_t LEVELS = 4;
+    static constexpr uint8_t SLOT_BITS = 4;
+    static constexpr uint8_t SLOTS = 1 << SLOT_BITS;
+    static constexpr uint8_t SLOT_MASK = SLOTS - 1;
+
+    EventInputBase* slots[LEVELS * SLOTS] = {};
+    EventInputBase* dueHead = nullptr;
+    uint16_t levelCount[LEVELS] = {};
+    uint16_t timerCount = 0;
+    uint32_t currentMs = 0;
+
+    /**
+     * @brief Place the input in the slot for its timerDueMs relative to currentMs.
+     */
+    void place(EventInputBase& input);
+
+    /**
+     * @brief Mark the input as due and add it to the due list.
+     */
+    void markDue(EventInputBase& input);
+
+    /**
+     * @brief Unlink the input from its slot or the due list (if any).
+     */
+    void unlink(EventInputBase& input);
+
+    /**
+     * @brief Move currentMs on to tickMs, cascade higher levels and mark the inputs in the level 0 slot as due.
+     */
+    void tick(uint32_t tickMs);
+
+};
+
+#endif